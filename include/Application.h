@@ -10,15 +10,24 @@ class ICommand;
 class Application {
 private:
     std::string host, port, dbname, user, password;
+    std::vector<std::string> replicas;
+    std::string readRouting;
+    std::vector<std::string> shards;
     
     void displayUsage() const;
+    
+    // Splits "host:port" (port defaults to 5432)
+    static void splitEndpoint(const std::string& endpoint, std::string& endpointHost, std::string& endpointPort);
 
     bool parseArguments(int argc, char* argv[], int& mode, std::vector<std::string>& args) const;
 
 public:
     Application(const std::string& host, const std::string& port,
                 const std::string& dbname, const std::string& user,
-                const std::string& password);
+                const std::string& password,
+                const std::vector<std::string>& replicas = {},
+                const std::string& readRouting = "round-robin",
+                const std::vector<std::string>& shards = {});
 
     int run(int argc, char* argv[]);
 };
@@ -0,0 +1,149 @@
+#ifndef COLUMNARFILE_H
+#define COLUMNARFILE_H
+
+#include "EmployeeRowView.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Columnar employee file written by the export mode (21).
+//
+//   FileHeader
+//   row group 0 .. n-1     (RowGroupHeader followed by its columns)
+//   uint64 offset[n]       (file offset of every row group)
+//   FileFooter
+//
+// Each row group stores its columns contiguously, 8-byte aligned:
+//   gender dictionary    uint32 offsets[entries + 1] + bytes
+//   gender codes         uint8 per row, index into the dictionary
+//   birth days           int32 per row, days since 2000-01-01
+//   ages                 uint8 per row
+//   name offsets         uint32 per row + 1
+//   name data            concatenated full_name bytes
+// Integers use the writer's byte order, recorded in the header and checked
+// by the reader, so a memory-mapped file is scanned without any decoding.
+namespace ColumnarFormat {
+    constexpr char MAGIC[8] = {'E', 'M', 'P', 'C', 'O', 'L', '0', '1'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrderMark;
+    };
+    
+    // Offsets are relative to the start of the row group
+    struct RowGroupHeader {
+        std::uint32_t rows;
+        std::uint32_t genderEntries;
+        std::uint64_t genderDictOffset;
+        std::uint64_t genderCodesOffset;
+        std::uint64_t birthDaysOffset;
+        std::uint64_t agesOffset;
+        std::uint64_t nameOffsetsOffset;
+        std::uint64_t nameDataOffset;
+        std::uint64_t size;
+    };
+    
+    struct FileFooter {
+        std::uint64_t rowGroupCount;
+        std::uint64_t totalRows;
+        std::uint64_t indexOffset;
+        char magic[8];
+    };
+    
+    static_assert(sizeof(FileHeader) == 16, "FileHeader must have no padding");
+    static_assert(sizeof(RowGroupHeader) == 64, "RowGroupHeader must have no padding");
+    static_assert(sizeof(FileFooter) == 32, "FileFooter must have no padding");
+}
+
+// Streams rows into a columnar file. Only the current row group is held in
+// memory; it is written out once it reaches rowGroupRows rows.
+class ColumnarWriter {
+private:
+    std::ofstream out;
+    std::uint32_t rowGroupRows;
+    std::vector<std::uint64_t> groupOffsets;
+    std::uint64_t totalRows;
+    bool finished;
+    
+    std::vector<std::string> genderDict;
+    std::unordered_map<std::string, std::uint8_t> genderCodes;
+    std::vector<std::uint8_t> codes;
+    std::vector<std::int32_t> birthDays;
+    std::vector<std::uint8_t> ages;
+    std::vector<std::uint32_t> nameOffsets;
+    std::string nameData;
+    
+    void flushRowGroup();
+    
+public:
+    static constexpr std::uint32_t DEFAULT_ROW_GROUP_ROWS = 65536;
+    
+    explicit ColumnarWriter(const std::string& path, std::uint32_t rowGroupRows = DEFAULT_ROW_GROUP_ROWS);
+    
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+    
+    void append(const EmployeeView& employee);
+    void append(const EmployeeResultSet& batch);
+    
+    // Writes the last row group, the row group index and the footer.
+    // A file that was never finished has no footer and is rejected by readers.
+    void finish();
+    
+    std::uint64_t rowCount() const { return totalRows; }
+    std::size_t rowGroupCount() const { return groupOffsets.size(); }
+};
+
+// Read-only, memory-mapped view of a columnar file
+class ColumnarReader {
+private:
+    int fd;
+    const char* data;
+    std::size_t fileSize;
+    const ColumnarFormat::FileFooter* footer;
+    const std::uint64_t* groupIndex;
+    
+public:
+    explicit ColumnarReader(const std::string& path);
+    ~ColumnarReader();
+    
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+    
+    class RowGroup {
+    private:
+        const char* base;
+        const ColumnarFormat::RowGroupHeader* header;
+        
+        template <typename T>
+        const T* column(std::uint64_t offset) const { return reinterpret_cast<const T*>(base + offset); }
+    
+    public:
+        explicit RowGroup(const char* base);
+        
+        std::size_t size() const { return header->rows; }
+        
+        // Column accessors for scans that touch only what they need
+        std::string_view genderEntry(std::uint8_t code) const;
+        const std::uint8_t* genderCodes() const { return column<std::uint8_t>(header->genderCodesOffset); }
+        const std::int32_t* birthDays() const { return column<std::int32_t>(header->birthDaysOffset); }
+        const std::uint8_t* ages() const { return column<std::uint8_t>(header->agesOffset); }
+        std::string_view fullName(std::size_t row) const;
+        
+        EmployeeView operator[](std::size_t row) const;
+    };
+    
+    std::uint64_t rowCount() const { return footer->totalRows; }
+    std::size_t rowGroupCount() const { return static_cast<std::size_t>(footer->rowGroupCount); }
+    std::size_t sizeBytes() const { return fileSize; }
+    
+    RowGroup rowGroup(std::size_t index) const;
+};
+
+#endif // COLUMNARFILE_H
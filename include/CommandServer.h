@@ -0,0 +1,62 @@
+#ifndef COMMANDSERVER_H
+#define COMMANDSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class DatabaseManager;
+
+// Long-running server for mode 8. A single poll() event loop owns the UNIX
+// socket and every client connection; complete requests are handed to a pool
+// of worker threads, each holding its own warm DatabaseManager with prepared
+// statements. Each client has at most one request in flight, so responses
+// come back in request order.
+class CommandServer {
+private:
+    struct Job {
+        unsigned long clientId;
+        std::string request;
+    };
+    
+    struct Reply {
+        unsigned long clientId;
+        std::string response;
+    };
+    
+    std::string socketPath;
+    int workerCount;
+    
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::deque<Job> jobs;
+    
+    std::mutex replyMutex;
+    std::deque<Reply> replies;
+    
+    int wakePipe[2];
+    std::atomic<bool> stopping;
+    
+    void workerLoop(DatabaseManager& db);
+    void submit(unsigned long clientId, std::string request);
+    void wakeEventLoop();
+    
+    static std::string handleRequest(DatabaseManager& db, const std::string& request);
+    
+public:
+    CommandServer(const std::string& socketPath, int workerCount);
+    ~CommandServer();
+    
+    CommandServer(const CommandServer&) = delete;
+    CommandServer& operator=(const CommandServer&) = delete;
+    
+    // Serves until SIGINT/SIGTERM. The given manager becomes the first pool
+    // connection; the remaining ones are opened with the same parameters.
+    void run(DatabaseManager& primary);
+};
+
+#endif // COMMANDSERVER_H
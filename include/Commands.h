@@ -4,7 +4,9 @@
 #include "ICommand.h"
 #include "DatabaseManager.h"
 #include "Employee.h"
+#include "WorkloadGenerator.h"
 #include <string>
+#include <vector>
 
 class CreateTableCommand : public ICommand {
 public:
@@ -48,4 +50,216 @@ public:
     const char* getDescription() const override { return "Optimize database"; }
 };
 
+class ScriptCommand : public ICommand {
+private:
+    std::string scriptPath;
+    
+public:
+    explicit ScriptCommand(const std::string& path);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Run command script"; }
+    
+    // Splits a script line into words; double quotes group words with spaces
+    static std::vector<std::string> tokenize(const std::string& line);
+};
+
+class ServeCommand : public ICommand {
+private:
+    std::string socketPath;
+    int workers;
+    
+public:
+    ServeCommand(const std::string& socketPath, int workers);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Serve commands over a UNIX socket"; }
+};
+
+class ClientCommand : public ICommand {
+private:
+    std::string socketPath;
+    std::vector<std::string> request;
+    
+public:
+    ClientCommand(const std::string& socketPath, const std::vector<std::string>& request);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Send request to command server"; }
+    bool requiresConnection() const override { return false; }
+};
+
+class ServerBenchmarkCommand : public ICommand {
+private:
+    std::string socketPath;
+    int iterations;
+    
+public:
+    ServerBenchmarkCommand(const std::string& socketPath, int iterations);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Benchmark server latency against one-shot CLI"; }
+    bool requiresConnection() const override { return false; }
+};
+
+class WorkloadCommand : public ICommand {
+private:
+    WorkloadSettings settings;
+    
+public:
+    explicit WorkloadCommand(const WorkloadSettings& settings);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Run mixed read/write workload"; }
+};
+
+class DecodeBenchmarkCommand : public ICommand {
+private:
+    int iterations;
+    
+public:
+    explicit DecodeBenchmarkCommand(int iterations);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Benchmark text tuples against binary row views"; }
+};
+
+class BulkLoadCommand : public ICommand {
+private:
+    int rowCount;
+    bool appendExisting;
+    
+public:
+    BulkLoadCommand(int rowCount, bool appendExisting);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Bulk load via UNLOGGED staging table"; }
+};
+
+class ResumableFillCommand : public ICommand {
+private:
+    std::string loadId;
+    long long totalRows;
+    std::vector<int> chunkSizes;
+    long long seed;
+    
+    struct LoadRun {
+        std::string loadId;
+        int chunkRows;
+        long long rowsLoaded;
+        double seconds;
+        int reconnects;
+    };
+    
+    // Runs (or resumes) one checkpointed load to completion
+    LoadRun runLoad(DatabaseManager& dbManager, const std::string& runId, int chunkRows);
+    
+public:
+    // With several chunk sizes, each runs as its own load "<loadId>-c<chunk_rows>"
+    ResumableFillCommand(const std::string& loadId, long long totalRows, const std::vector<int>& chunkSizes,
+                         long long seed);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Checkpointed, resumable fill"; }
+};
+
+class EndpointStatsCommand : public ICommand {
+private:
+    int reads;
+    
+public:
+    explicit EndpointStatsCommand(int reads);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Endpoint health and latency statistics"; }
+};
+
+class ShardedCommand : public ICommand {
+private:
+    std::string action;
+    std::vector<std::string> args;
+    
+public:
+    ShardedCommand(const std::string& action, const std::vector<std::string>& args);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Sharded operation across Config::DB_SHARDS"; }
+    bool requiresConnection() const override { return false; }
+};
+
+class NameSearchCommand : public ICommand {
+private:
+    DatabaseManager::NameMatch match;
+    std::string term;
+    int limit;
+    double threshold;
+    
+public:
+    NameSearchCommand(DatabaseManager::NameMatch match, const std::string& term, int limit, double threshold);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Ranked substring/fuzzy name search"; }
+};
+
+class NameSearchBenchmarkCommand : public ICommand {
+private:
+    std::string substringTerm;
+    std::string fuzzyTerm;
+    
+public:
+    NameSearchBenchmarkCommand(const std::string& substringTerm, const std::string& fuzzyTerm);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Trigram index vs seq scan name search benchmark"; }
+};
+
+class ApproximateQueryCommand : public ICommand {
+private:
+    std::string gender;
+    std::string lastNameStartsWith;
+    double percent;
+    int seed;
+    
+public:
+    ApproximateQueryCommand(const std::string& gender, const std::string& lastNameStartsWith,
+                            double percent, int seed);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Approximate count and age histogram"; }
+};
+
+class AggregateReportCommand : public ICommand {
+private:
+    int parallelWorkers;
+    
+public:
+    explicit AggregateReportCommand(int parallelWorkers);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Server-side aggregate report"; }
+};
+
+class ScaleLadderCommand : public ICommand {
+private:
+    std::vector<long long> sizes;
+    double targetedRatio;
+    std::string outputPrefix;
+    
+public:
+    ScaleLadderCommand(const std::vector<long long>& sizes, double targetedRatio, const std::string& outputPrefix);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Load and query scaling benchmark"; }
+};
+
+class ColumnarExportCommand : public ICommand {
+private:
+    std::string path;
+    std::string gender;
+    std::string lastNameStartsWith;
+    
+public:
+    // Empty gender exports the full listing (mode 3), otherwise the criteria query (mode 5)
+    ColumnarExportCommand(const std::string& path, const std::string& gender, const std::string& lastNameStartsWith);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Export employees to a columnar file"; }
+};
+
+class ColumnarScanCommand : public ICommand {
+private:
+    std::string path;
+    int printRows;
+    
+public:
+    ColumnarScanCommand(const std::string& path, int printRows);
+    void execute(DatabaseManager& dbManager) override;
+    const char* getDescription() const override { return "Scan a columnar export file"; }
+    bool requiresConnection() const override { return false; }
+};
+
 #endif // COMMANDS_H
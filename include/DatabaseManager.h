@@ -3,20 +3,88 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <tuple>
+#include <map>
+#include <functional>
 #include <pqxx/pqxx>
+#include "InsertSerializer.h"
+#include "EmployeeRowView.h"
 
 class Employee;
+class ReplicaRouter;
+class ShardedDatabase;
+
+// Durable progress of a resumable load (mode 14), stored in load_checkpoints
+struct LoadCheckpoint {
+    std::string loadId;
+    long long seed;
+    long long totalRows;
+    int chunkRows;
+    long long rowsCommitted;
+};
+
+// Estimated number of matching rows (mode 18), overall and per 10-year age
+// band (key = age / 10). stdError is 0 when the source gives no error
+// bound, as with planner statistics.
+struct ApproximateCount {
+    double estimate = 0.0;
+    double stdError = 0.0;
+    std::map<int, double> ageBands;
+    std::map<int, double> ageBandErrors;
+    long long rowsRead = 0;
+};
+
+// Summary of the employees table (mode 19). wireBytes is the size of the
+// DataRow messages the query returned, i.e. what crossed the wire.
+struct AggregateReport {
+    std::map<std::pair<std::string, std::string>, long long> byGenderInitial;
+    std::map<int, long long> ageBands;
+    long long totalRows = 0;
+    long long duplicateGroups = 0;
+    long long duplicateRows = 0;
+    long long rowsTransferred = 0;
+    long long wireBytes = 0;
+    int workersPlanned = 0;
+};
+
+// On-disk size of employees: heap (with TOAST) and all of its indexes
+struct RelationSizes {
+    long long tableBytes = 0;
+    long long indexBytes = 0;
+};
 
 class DatabaseManager {
 private:
     pqxx::connection* conn;
     std::string connectionString;
+    InsertSerializer insertBuffer;
+    bool statementsPrepared;
+    std::unique_ptr<BinaryConnection> binaryConn;
+    std::vector<std::string> sessionSettings;
+    std::unique_ptr<ReplicaRouter> router;
+    std::unique_ptr<ShardedDatabase> shardSet;
+    // (staging name, original name) of indexes built by buildStagingIndexes(),
+    // renamed back by swapStagingTable()
+    std::vector<std::pair<std::string, std::string>> stagedIndexes;
+    
+    void insertEmployeeRows(pqxx::work& txn, const std::vector<Employee>& employees,
+                            const std::string& table);
+    
+    // Unrouted implementations of the read queries; the public methods send
+    // them to a replica when read routing is enabled
+    std::vector<std::tuple<std::string, std::string, std::string, int>> readAllEmployees();
+    std::vector<std::tuple<std::string, std::string, std::string, int>> 
+        readEmployeesByCriteria(const std::string& gender, const std::string& lastNameStartsWith);
+    EmployeeResultSet readAllEmployeeViews();
 
 public:
     DatabaseManager(const std::string& host, const std::string& port, 
                    const std::string& dbname, const std::string& user, 
                    const std::string& password);
     
+    explicit DatabaseManager(const std::string& connectionString);
+    
     ~DatabaseManager();
     
     DatabaseManager(const DatabaseManager&) = delete;
@@ -28,18 +96,96 @@ public:
     void connect();
     void disconnect();
     
+    // Drops the current session (if any) and opens a new one
+    void reconnect();
+    
+    // True while a session is open; false after disconnect() or a failed connect()
+    bool isConnected() const;
+    
+    const std::string& getConnectionString() const;
+    
+    // Prepares the per-session statements once; they stay valid for the
+    // lifetime of the connection, so script and server modes reuse them.
+    void prepareStatements();
+    
     void createTable();
     
     void insertEmployee(const std::string& fullName, const std::string& birthDate, 
                        const std::string& gender);
     
-    void batchInsertEmployees(const std::vector<Employee>& employees);
+    void batchInsertEmployees(const std::vector<Employee>& employees,
+                              const std::string& table = "employees");
+    
+    // batchInsertEmployees without console output, for callers that insert on
+    // several connections at once and report after all of them have finished
+    void insertEmployeesSilently(const std::vector<Employee>& employees,
+                                 const std::string& table = "employees");
     
     std::vector<std::tuple<std::string, std::string, std::string, int>> getAllEmployees();
     
     std::vector<std::tuple<std::string, std::string, std::string, int>> 
         getEmployeesByCriteria(const std::string& gender, const std::string& lastNameStartsWith);
     
+    // Binary-format variants of the queries above; rows are decoded lazily
+    // into views over the result buffer instead of per-row strings
+    EmployeeResultSet getAllEmployeeViews();
+    
+    EmployeeResultSet getEmployeeViewsByCriteria(const std::string& gender, const std::string& lastNameStartsWith);
+    
+    // Same query, always on this connection; for measurements that must
+    // describe the server the rows were just written to
+    EmployeeResultSet readEmployeeViewsByCriteria(const std::string& gender, const std::string& lastNameStartsWith);
+    
+    // Runs sql, which must return (full_name, birth_date, gender, age int4),
+    // through a cursor on the binary session and hands each batch of up to
+    // fetchRows rows to visit, so memory stays bounded for any table size.
+    // Returns the number of rows streamed.
+    long long streamEmployeeViews(const std::string& sql, int fetchRows,
+                                  const std::function<void(const EmployeeResultSet&)>& visit);
+    
+    // The getAllEmployeeViews() listing, streamed in batches
+    long long streamAllEmployeeViews(int fetchRows, const std::function<void(const EmployeeResultSet&)>& visit);
+    
+    // The getEmployeeViewsByCriteria() query, streamed in batches
+    long long streamEmployeeViewsByCriteria(const std::string& gender, const std::string& lastNameStartsWith,
+                                            int fetchRows, const std::function<void(const EmployeeResultSet&)>& visit);
+    
+    // Removes every employee and restarts the id sequence
+    void truncateEmployees();
+    
+    RelationSizes getEmployeeTableSizes();
+    
+    // Applies a SET statement to every session of this manager and replays
+    // it on sessions opened later
+    void applySessionSetting(const std::string& sql);
+    
+    // Returns the stored checkpoint for loadId, creating it from the given
+    // parameters on first use. A resumed load always uses the stored values.
+    LoadCheckpoint beginCheckpointedLoad(const std::string& loadId, long long seed,
+                                         long long totalRows, int chunkRows);
+    
+    // Inserts one chunk and advances the checkpoint in the same transaction,
+    // so a chunk is either fully committed and recorded or not at all
+    void commitCheckpointedChunk(const LoadCheckpoint& checkpoint, const std::vector<Employee>& employees);
+    
+    LoadCheckpoint readCheckpoint(const std::string& loadId);
+    
+    // Fast bulk load (mode 13): rows go into an UNLOGGED copy of employees
+    // without indexes, the table is switched to LOGGED while still unindexed,
+    // indexes are built once with parallel maintenance workers and the
+    // staging table then replaces employees.
+    static const char* const STAGING_TABLE;
+    
+    void createStagingTable(bool copyExistingRows);
+    
+    void buildStagingIndexes();
+    
+    void setStagingLogged();
+    
+    void analyzeStagingTable();
+    
+    void swapStagingTable();
+    
     void createOptimizationIndex();
     
     void dropIndex();
@@ -48,7 +194,65 @@ public:
     
     void explainQuery(const std::string& gender, const std::string& lastNameStartsWith);
     
+    // Horvitz-Thompson estimate from TABLESAMPLE method ("SYSTEM" or
+    // "BERNOULLI") at the given percentage; the sample is repeatable per seed.
+    // The error accounts for block clustering of SYSTEM samples.
+    ApproximateCount sampleEmployeesByCriteria(const std::string& gender, const std::string& lastNameStartsWith,
+                                               const std::string& method, double percent, int seed);
+    
+    // Planner row estimate for the criteria query, split into age bands by
+    // the birth_date histogram in pg_stats
+    ApproximateCount estimateEmployeesByCriteria(const std::string& gender, const std::string& lastNameStartsWith);
+    
+    // pg_class.reltuples of employees; -1 if the table was never analyzed
+    double estimatedTableRows();
+    
+    // Aggregates computed by the server with up to parallelWorkers workers
+    // per Gather; only the grouped rows are returned
+    AggregateReport buildAggregateReport(int parallelWorkers);
+    
+    // Same report computed here from every row of employees
+    AggregateReport buildAggregateReportClientSide();
+    
+    // Name search (mode 17) backed by a pg_trgm GIN index on full_name.
+    // SUBSTRING matches ILIKE '%term%'; FUZZY matches whole words of the
+    // name within a word_similarity threshold, so typos still hit.
+    enum class NameMatch { SUBSTRING, FUZZY };
+    
+    static const double DEFAULT_FUZZY_THRESHOLD;
+    
+    // Creates pg_trgm and idx_<table>_name_trgm; also step 3 of createOptimizationIndex()
+    void createTrigramIndex(const std::string& table = "employees");
+    
+    // Unique (full_name, birth_date) rows ranked by similarity to term, best first;
+    // the last tuple element is the score
+    std::vector<std::tuple<std::string, std::string, std::string, int, double>>
+        searchEmployeesByName(const std::string& term, NameMatch match, int limit,
+                              double fuzzyThreshold = DEFAULT_FUZZY_THRESHOLD,
+                              const std::string& table = "employees");
+    
     pqxx::connection* getConnection();
+    
+    // Opens the binary-result session on first use
+    BinaryConnection& getBinaryConnection();
+    
+    // Opens the binary-result session and prepares the mode 3 and mode 5 view
+    // queries on it, so timed view queries do not pay for the second backend
+    void prepareViewStatements();
+    
+    // Read/write routing: reads (modes 3, 5, ...) go to healthy replicas
+    // chosen by policy ("round-robin" or "least-latency"), writes stay here
+    void enableReadRouting(const std::string& primaryName, const std::string& policy);
+    
+    void addReadReplica(const std::string& name, std::unique_ptr<DatabaseManager> replica);
+    
+    // Null unless read routing is enabled
+    ReplicaRouter* getReadRouter();
+    
+    // Shards used by the sharded mode (16); null unless configured
+    void setShards(std::unique_ptr<ShardedDatabase> shards);
+    
+    ShardedDatabase* getShards();
 };
 
 #endif // DATABASEMANAGER_H
@@ -15,9 +15,9 @@ private:
 public:
     Employee(const std::string& name, const std::string& date, const std::string& gender);
     
-    std::string getFullName() const;
-    std::string getBirthDate() const;
-    std::string getGender() const;
+    const std::string& getFullName() const;
+    const std::string& getBirthDate() const;
+    const std::string& getGender() const;
     
     int calculateAge() const;
     
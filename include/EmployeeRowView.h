@@ -0,0 +1,98 @@
+#ifndef EMPLOYEEROWVIEW_H
+#define EMPLOYEEROWVIEW_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct pg_conn;
+struct pg_result;
+
+// One employee row decoded from a binary-format result. The string views
+// point straight into the libpq result buffer and stay valid as long as the
+// owning EmployeeResultSet is alive.
+struct EmployeeView {
+    std::string_view fullName;
+    std::int32_t birthDays;      // days since 2000-01-01, PostgreSQL's DATE encoding
+    std::string_view gender;
+    std::int32_t age;
+    
+    // Longest rendering: a 7-digit year with " BC", e.g. "5877642-06-23 BC"
+    static constexpr std::size_t DATE_BUFFER_SIZE = 17;
+    
+    // Writes birth_date the way the server's ISO DateStyle prints it (YYYY-MM-DD,
+    // wider years as needed, " BC" before year 1, [-]infinity) without allocating
+    std::string_view birthDate(char (&buffer)[DATE_BUFFER_SIZE]) const;
+};
+
+// Owns a binary-format PGresult with the columns
+// (full_name text, birth_date date, gender text, age int4)
+// and decodes rows on access, so iterating never allocates per row.
+class EmployeeResultSet {
+private:
+    pg_result* result;
+    int rowCount;
+    
+public:
+    explicit EmployeeResultSet(pg_result* result);
+    ~EmployeeResultSet();
+    
+    EmployeeResultSet(const EmployeeResultSet&) = delete;
+    EmployeeResultSet& operator=(const EmployeeResultSet&) = delete;
+    
+    EmployeeResultSet(EmployeeResultSet&& other) noexcept;
+    EmployeeResultSet& operator=(EmployeeResultSet&& other) noexcept;
+    
+    std::size_t size() const { return static_cast<std::size_t>(rowCount); }
+    bool empty() const { return rowCount == 0; }
+    
+    EmployeeView operator[](std::size_t row) const;
+    
+    class const_iterator {
+    private:
+        const EmployeeResultSet* owner;
+        std::size_t row;
+        
+    public:
+        const_iterator(const EmployeeResultSet* owner, std::size_t row) : owner(owner), row(row) {}
+        EmployeeView operator*() const { return (*owner)[row]; }
+        const_iterator& operator++() { ++row; return *this; }
+        bool operator!=(const const_iterator& other) const { return row != other.row; }
+    };
+    
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+};
+
+// Plain libpq session that requests results in binary format. libpqxx only
+// hands out text results, so DatabaseManager keeps one of these next to its
+// pqxx connection for the row-view queries.
+class BinaryConnection {
+private:
+    pg_conn* conn;
+    std::vector<std::string> preparedNames;
+    
+public:
+    explicit BinaryConnection(const std::string& connectionString);
+    ~BinaryConnection();
+    
+    BinaryConnection(const BinaryConnection&) = delete;
+    BinaryConnection& operator=(const BinaryConnection&) = delete;
+    
+    // Runs a statement that returns no rows (SET, DECLARE, ...)
+    void execute(const std::string& sql);
+    
+    // Prepares sql under name unless a statement of that name already exists
+    void prepare(const std::string& name, const std::string& sql, int paramCount);
+    
+    // Prepares sql under name on first use, then executes it with text
+    // parameters and binary results
+    EmployeeResultSet queryEmployees(const std::string& name, const std::string& sql,
+                                     const std::vector<std::string>& params);
+    
+    // One-off query with binary results, e.g. FETCH from a cursor
+    EmployeeResultSet queryEmployees(const std::string& sql);
+};
+
+#endif // EMPLOYEEROWVIEW_H
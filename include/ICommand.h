@@ -11,6 +11,9 @@ public:
     virtual void execute(DatabaseManager& dbManager) = 0;
     
     virtual const char* getDescription() const = 0;
+    
+    // Commands that only talk to a running server do not need a database connection
+    virtual bool requiresConnection() const { return true; }
 };
 
 #endif // ICOMMAND_H
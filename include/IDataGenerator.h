@@ -2,6 +2,7 @@
 #define IDATAGENERATOR_H
 
 #include "Employee.h"
+#include <cstdint>
 #include <vector>
 
 class IDataGenerator {
@@ -9,11 +10,17 @@ public:
     virtual ~IDataGenerator() = default;
 
     virtual std::vector<Employee> generateEmployees(int count) = 0;
+    
+    // Rows [firstRow, firstRow + count) of the stream defined by seed. Each row
+    // depends only on (seed, row index), so any range can be regenerated
+    // identically, e.g. when a load resumes after a failure.
+    virtual std::vector<Employee> generateRange(std::uint64_t seed, long long firstRow, int count) = 0;
 };
 
 class RandomDataGenerator : public IDataGenerator {
 public:
     std::vector<Employee> generateEmployees(int count) override;
+    std::vector<Employee> generateRange(std::uint64_t seed, long long firstRow, int count) override;
 };
 
 class TargetedDataGenerator : public IDataGenerator {
@@ -24,6 +31,7 @@ private:
 public:
     TargetedDataGenerator(const std::string& gender, char startingLetter);
     std::vector<Employee> generateEmployees(int count) override;
+    std::vector<Employee> generateRange(std::uint64_t seed, long long firstRow, int count) override;
 };
 
 #endif // IDATAGENERATOR_H
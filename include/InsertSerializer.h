@@ -0,0 +1,45 @@
+#ifndef INSERTSERIALIZER_H
+#define INSERTSERIALIZER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+class Employee;
+
+// Builds multi-row INSERT statements for the employees table in a single
+// reusable buffer. Rows are appended until the chunk is full, the caller
+// executes statement() and calls reset(); the buffer keeps its capacity, so
+// after the first chunk no further allocations happen and peak memory is
+// bounded by the chunk size rather than by the total number of rows.
+class InsertSerializer {
+private:
+    std::string buffer;
+    std::size_t prefixLength;
+    std::size_t chunkRows;
+    std::size_t rowsInChunk;
+
+    void appendLiteral(std::string_view value);
+
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_ROWS = 5000;
+
+    explicit InsertSerializer(std::size_t chunkRows = DEFAULT_CHUNK_ROWS);
+    
+    // Target table for subsequent statements (default: employees); clears the chunk
+    void setTable(const std::string& table);
+
+    void append(const Employee& employee);
+    void append(std::string_view fullName, std::string_view birthDate, std::string_view gender);
+
+    bool full() const { return rowsInChunk >= chunkRows; }
+    bool empty() const { return rowsInChunk == 0; }
+    std::size_t rows() const { return rowsInChunk; }
+    std::size_t capacity() const { return buffer.capacity(); }
+
+    const std::string& statement() const { return buffer; }
+
+    void reset();
+};
+
+#endif // INSERTSERIALIZER_H
@@ -0,0 +1,44 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+// HDR-style histogram of latencies in microseconds. Buckets are log-linear:
+// every power-of-two range is split into 2048 linear sub-buckets, which keeps
+// three significant digits at any magnitude with a fixed, small footprint.
+// Values above the trackable maximum are clamped to it.
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BUCKET_BITS = 11;
+    static constexpr std::int64_t SUB_BUCKET_COUNT = std::int64_t(1) << SUB_BUCKET_BITS;
+    static constexpr std::int64_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+    static constexpr std::int64_t SUB_BUCKET_MASK = SUB_BUCKET_COUNT - 1;
+    
+    std::int64_t highestTrackable;
+    std::vector<std::int64_t> counts;
+    std::int64_t totalCount;
+    std::int64_t minValue;
+    std::int64_t maxValue;
+    double sum;
+    
+    std::size_t indexFor(std::int64_t value) const;
+    std::int64_t highestEquivalentValue(std::size_t index) const;
+    
+public:
+    // Default range covers 1 us .. 1 hour
+    explicit LatencyHistogram(std::int64_t highestTrackableMicros = 3600LL * 1000 * 1000);
+    
+    void record(std::int64_t micros);
+    void merge(const LatencyHistogram& other);
+    
+    std::int64_t count() const { return totalCount; }
+    std::int64_t min() const { return totalCount ? minValue : 0; }
+    std::int64_t max() const { return maxValue; }
+    double mean() const { return totalCount ? sum / totalCount : 0.0; }
+    
+    // Smallest recorded value v such that `percentile` percent of samples are <= v
+    std::int64_t valueAtPercentile(double percentile) const;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,40 @@
+#ifndef LOCALPROTOCOL_H
+#define LOCALPROTOCOL_H
+
+#include <cstdint>
+#include <string>
+
+// Length-prefixed framing used between the command server (mode 8) and its
+// clients over a UNIX domain socket. Every frame is a 4-byte big-endian
+// payload length followed by the payload.
+//
+// Request payload:  one command line, e.g. `query Male F`,
+//                   `insert "Smith John Michael" 1990-05-15 Male`, `list`, `ping`
+// Response payload: `OK <rows>` or `ERR <message>` on the first line, then one
+//                   tab-separated row per line: full_name, birth_date, gender, age
+namespace LocalProtocol {
+    const std::string DEFAULT_SOCKET_PATH = "/tmp/sqlmanager.sock";
+    
+    // Requests are single command lines; anything bigger is a broken client
+    const std::uint32_t MAX_REQUEST_SIZE = 64 * 1024;
+    
+    const std::size_t HEADER_SIZE = 4;
+    
+    void encodeHeader(std::uint32_t length, unsigned char* header);
+    std::uint32_t decodeHeader(const unsigned char* header);
+    
+    // Appends a complete frame (header and payload) to out
+    void appendFrame(std::string& out, const std::string& payload);
+    
+    // Blocking helpers for clients; return false on EOF or I/O error
+    bool writeFrame(int fd, const std::string& payload);
+    bool readFrame(int fd, std::string& payload);
+    
+    // Connects to the server socket, throws std::runtime_error on failure
+    int connectTo(const std::string& socketPath);
+    
+    // Joins words into a request line, quoting words that contain whitespace
+    std::string joinRequest(const std::string* begin, const std::string* end);
+}
+
+#endif // LOCALPROTOCOL_H
@@ -0,0 +1,127 @@
+#ifndef REPLICAROUTER_H
+#define REPLICAROUTER_H
+
+#include "DatabaseManager.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Routes read queries of a DatabaseManager to streaming replicas while all
+// writes stay on the primary. Replicas are health-checked periodically
+// (SELECT pg_is_in_recovery()); a replica that fails a check or a query is
+// skipped until a later check succeeds, and reads fall back to the primary
+// when no replica is healthy.
+class ReplicaRouter {
+public:
+    enum class Policy { ROUND_ROBIN, LEAST_LATENCY };
+    
+    struct EndpointStats {
+        std::string name;
+        std::string role;
+        bool healthy = false;
+        bool inRecovery = false;
+        long long reads = 0;
+        long long failures = 0;
+        double totalMs = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        double ewmaMs = 0.0;         // smoothed read/health-check latency, used by LEAST_LATENCY
+        double lastCheckMs = 0.0;
+    };
+    
+private:
+    struct Endpoint {
+        std::unique_ptr<DatabaseManager> db;    // null for the primary entry
+        EndpointStats stats;
+        std::chrono::steady_clock::time_point lastCheck;
+    };
+    
+    DatabaseManager& primary;
+    std::vector<Endpoint> endpoints;            // [0] is the primary
+    Policy policy;
+    std::size_t nextReplica;
+    std::chrono::milliseconds checkInterval;
+    
+    DatabaseManager& managerFor(Endpoint& endpoint);
+    void checkEndpoint(Endpoint& endpoint);
+    void recordLatency(EndpointStats& stats, double ms);
+    
+public:
+    ReplicaRouter(DatabaseManager& primary, const std::string& primaryName, Policy policy);
+    ~ReplicaRouter();
+    
+    ReplicaRouter(const ReplicaRouter&) = delete;
+    ReplicaRouter& operator=(const ReplicaRouter&) = delete;
+    
+    static Policy parsePolicy(const std::string& name);
+    
+    // Takes an unconnected manager for the replica; it is connected by the next health check
+    void addReplica(const std::string& name, std::unique_ptr<DatabaseManager> replica);
+    
+    bool hasReplicas() const { return endpoints.size() > 1; }
+    
+    void healthCheck();
+    
+    // Runs read on a healthy replica chosen by the policy, or on the primary
+    // if none is available. A replica error marks it unhealthy and retries on
+    // the primary.
+    template <typename Read>
+    auto route(Read&& read) -> decltype(read(std::declval<DatabaseManager&>()));
+    
+    void applySessionSetting(const std::string& sql);
+    
+    std::vector<EndpointStats> stats() const;
+};
+
+template <typename Read>
+auto ReplicaRouter::route(Read&& read) -> decltype(read(std::declval<DatabaseManager&>())) {
+    using Clock = std::chrono::steady_clock;
+    
+    auto now = Clock::now();
+    for (std::size_t i = 1; i < endpoints.size(); ++i) {
+        if (now - endpoints[i].lastCheck >= checkInterval) {
+            checkEndpoint(endpoints[i]);
+        }
+    }
+    
+    std::size_t chosen = 0;
+    std::size_t replicaCount = endpoints.size() - 1;
+    if (policy == Policy::ROUND_ROBIN) {
+        for (std::size_t step = 0; step < replicaCount; ++step) {
+            std::size_t candidate = 1 + (nextReplica + step) % replicaCount;
+            if (endpoints[candidate].stats.healthy) {
+                chosen = candidate;
+                nextReplica = candidate % replicaCount;
+                break;
+            }
+        }
+    } else {
+        for (std::size_t i = 1; i < endpoints.size(); ++i) {
+            if (endpoints[i].stats.healthy &&
+                (chosen == 0 || endpoints[i].stats.ewmaMs < endpoints[chosen].stats.ewmaMs)) {
+                chosen = i;
+            }
+        }
+    }
+    
+    Endpoint& endpoint = endpoints[chosen];
+    auto start = Clock::now();
+    try {
+        auto result = read(managerFor(endpoint));
+        recordLatency(endpoint.stats, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        ++endpoint.stats.reads;
+        return result;
+    } catch (const std::exception&) {
+        ++endpoint.stats.failures;
+        if (chosen == 0) {
+            throw;
+        }
+        endpoint.stats.healthy = false;
+        endpoint.lastCheck = Clock::now();
+        return route(std::forward<Read>(read));
+    }
+}
+
+#endif // REPLICAROUTER_H
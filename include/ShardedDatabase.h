@@ -0,0 +1,72 @@
+#ifndef SHARDEDDATABASE_H
+#define SHARDEDDATABASE_H
+
+#include "EmployeeRowView.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class DatabaseManager;
+class Employee;
+
+// Client-side sharding of the employees table across several Postgres
+// instances (mode 16). Rows are placed by a 64-bit FNV-1a hash of full_name,
+// so all rows with the same name live on one shard and per-shard DISTINCT ON
+// (full_name, birth_date) stays globally correct. Reads run on every shard
+// in parallel and the sorted partial results are k-way merged on the client.
+class ShardedDatabase {
+public:
+    struct ShardTiming {
+        std::string name;
+        long long rows = 0;
+        double ms = 0.0;
+    };
+    
+    // Rows of a scatter-gather query. The views point into `parts`, which
+    // must stay alive as long as `rows` is used.
+    struct MergedResult {
+        std::vector<EmployeeResultSet> parts;
+        std::vector<EmployeeView> rows;
+        std::vector<ShardTiming> shards;
+        double mergeMs = 0.0;
+    };
+    
+private:
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<DatabaseManager>> shards;
+    
+    MergedResult scatterGather(const std::string& statementName, const std::string& sql,
+                               const std::vector<std::string>& params, bool byBirthDate);
+    
+public:
+    ShardedDatabase();
+    ~ShardedDatabase();
+    
+    ShardedDatabase(const ShardedDatabase&) = delete;
+    ShardedDatabase& operator=(const ShardedDatabase&) = delete;
+    
+    // Takes an unconnected manager; shards are connected by connectAll()
+    void addShard(const std::string& name, std::unique_ptr<DatabaseManager> shard);
+    
+    std::size_t size() const { return shards.size(); }
+    
+    static std::size_t shardFor(const std::string& fullName, std::size_t shardCount);
+    
+    void connectAll();
+    
+    std::vector<ShardTiming> createTable();
+    
+    // Returns the name of the shard that received the row
+    std::string insertEmployee(const std::string& fullName, const std::string& birthDate,
+                               const std::string& gender);
+    
+    // Partitions by shard and inserts all partitions in parallel
+    std::vector<ShardTiming> batchInsertEmployees(const std::vector<Employee>& employees);
+    
+    MergedResult getAllEmployees();
+    
+    MergedResult getEmployeesByCriteria(const std::string& gender, const std::string& lastNameStartsWith);
+};
+
+#endif // SHARDEDDATABASE_H
@@ -0,0 +1,50 @@
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include "LatencyHistogram.h"
+#include <string>
+#include <vector>
+
+class DatabaseManager;
+
+struct WorkloadSettings {
+    int readPercent = 80;           // share of criteria queries, the rest are inserts
+    double targetRate = 50.0;       // scheduled operations per second (all workers)
+    int durationSeconds = 30;
+    int concurrency = 4;            // worker threads, one connection each
+    std::string gender = "Male";
+    std::string lastNamePrefix = "F";
+};
+
+// Open-loop mixed read/write load generator for mode 11. Operation i is
+// scheduled at start + i / targetRate regardless of how long earlier
+// operations took, and its response time is measured from that intended
+// start. A stalled server therefore shows up as queueing delay in the
+// percentiles instead of silently lowering the offered load (coordinated
+// omission). Service time, measured from the actual start, is kept separately.
+class WorkloadGenerator {
+public:
+    enum OperationType { READ = 0, WRITE = 1, OPERATION_TYPES = 2 };
+    
+    struct Stats {
+        LatencyHistogram responseTime[OPERATION_TYPES];
+        LatencyHistogram serviceTime[OPERATION_TYPES];
+        long long errors[OPERATION_TYPES] = {0, 0};
+        std::vector<long long> completedPerSecond[OPERATION_TYPES];
+        
+        void merge(const Stats& other);
+    };
+    
+private:
+    WorkloadSettings settings;
+    
+    void printReport(const Stats& stats, double elapsedSeconds, long long scheduled) const;
+    
+public:
+    explicit WorkloadGenerator(const WorkloadSettings& settings);
+    
+    // The given manager serves the first worker; the rest open their own connections
+    void run(DatabaseManager& primary);
+};
+
+#endif // WORKLOADGENERATOR_H
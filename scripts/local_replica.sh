@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+# Starts a local primary and a streaming replica for testing read routing.
+#
+#   scripts/local_replica.sh start [base_dir] [primary_port] [replica_port]
+#   scripts/local_replica.sh stop  [base_dir]
+#
+# Then set in include/config.h:
+#   DB_PORT = "<primary_port>"; DB_REPLICAS = {"localhost:<replica_port>"};
+set -euo pipefail
+
+ACTION=${1:-start}
+BASE=${2:-/tmp/sqlmanager-cluster}
+PRIMARY_PORT=${3:-5433}
+REPLICA_PORT=${4:-5434}
+DB_NAME=employees_db
+DB_USER=postgres
+DB_PASSWORD=postgres
+
+PG_BIN=${PG_BIN:-$(pg_config --bindir)}
+
+case "$ACTION" in
+    start)
+        mkdir -p "$BASE"
+        echo "$DB_PASSWORD" > "$BASE/pwfile"
+        
+        "$PG_BIN/initdb" -D "$BASE/primary" -U "$DB_USER" --pwfile="$BASE/pwfile" -A md5 >/dev/null
+        cat >> "$BASE/primary/postgresql.conf" <<CONF
+port = $PRIMARY_PORT
+wal_level = replica
+max_wal_senders = 4
+hot_standby = on
+CONF
+        echo "host replication $DB_USER 127.0.0.1/32 md5" >> "$BASE/primary/pg_hba.conf"
+        "$PG_BIN/pg_ctl" -D "$BASE/primary" -l "$BASE/primary.log" -w start
+        PGPASSWORD=$DB_PASSWORD "$PG_BIN/createdb" -h localhost -p "$PRIMARY_PORT" -U "$DB_USER" "$DB_NAME"
+        
+        PGPASSWORD=$DB_PASSWORD "$PG_BIN/pg_basebackup" -h localhost -p "$PRIMARY_PORT" -U "$DB_USER" \
+            -D "$BASE/replica" -R -X stream
+        echo "port = $REPLICA_PORT" >> "$BASE/replica/postgresql.conf"
+        "$PG_BIN/pg_ctl" -D "$BASE/replica" -l "$BASE/replica.log" -w start
+        
+        echo "Primary: localhost:$PRIMARY_PORT, replica: localhost:$REPLICA_PORT (database $DB_NAME)"
+        ;;
+    stop)
+        for node in replica primary; do
+            if [ -d "$BASE/$node" ]; then
+                "$PG_BIN/pg_ctl" -D "$BASE/$node" -m fast stop || true
+            fi
+        done
+        rm -rf "$BASE"
+        ;;
+    *)
+        echo "Usage: $0 start|stop [base_dir] [primary_port] [replica_port]" >&2
+        exit 1
+        ;;
+esac
@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+# Starts N independent local PostgreSQL instances on consecutive ports for sharding.
+#
+#   scripts/local_shards.sh start [base_dir] [count] [first_port]
+#   scripts/local_shards.sh stop  [base_dir]
+#
+# Then set in include/config.h:
+#   DB_SHARDS = {"localhost:<first_port>", "localhost:<first_port + 1>", ...};
+set -euo pipefail
+
+ACTION=${1:-start}
+BASE=${2:-/tmp/sqlmanager-shards}
+COUNT=${3:-3}
+FIRST_PORT=${4:-5441}
+DB_NAME=employees_db
+DB_USER=postgres
+DB_PASSWORD=postgres
+
+PG_BIN=${PG_BIN:-$(pg_config --bindir)}
+
+case "$ACTION" in
+    start)
+        mkdir -p "$BASE"
+        echo "$DB_PASSWORD" > "$BASE/pwfile"
+        
+        SHARDS=()
+        for ((i = 0; i < COUNT; i++)); do
+            PORT=$((FIRST_PORT + i))
+            "$PG_BIN/initdb" -D "$BASE/shard$i" -U "$DB_USER" --pwfile="$BASE/pwfile" -A md5 >/dev/null
+            echo "port = $PORT" >> "$BASE/shard$i/postgresql.conf"
+            "$PG_BIN/pg_ctl" -D "$BASE/shard$i" -l "$BASE/shard$i.log" -w start
+            PGPASSWORD=$DB_PASSWORD "$PG_BIN/createdb" -h localhost -p "$PORT" -U "$DB_USER" "$DB_NAME"
+            SHARDS+=("\"localhost:$PORT\"")
+        done
+        
+        echo "DB_SHARDS = {$(IFS=,; echo "${SHARDS[*]}" | sed 's/,/, /g')};"
+        ;;
+    stop)
+        for dir in "$BASE"/shard*/; do
+            if [ -d "$dir" ]; then
+                "$PG_BIN/pg_ctl" -D "$dir" -m fast stop || true
+            fi
+        done
+        rm -rf "$BASE"
+        ;;
+    *)
+        echo "Usage: $0 start|stop [base_dir] [count] [first_port]" >&2
+        exit 1
+        ;;
+esac
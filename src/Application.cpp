@@ -2,15 +2,27 @@
 #include "DatabaseManager.h"
 #include "CommandFactory.h"
 #include "ICommand.h"
+#include "ShardedDatabase.h"
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 Application::Application(const std::string& host_, const std::string& port_,
                          const std::string& dbname_, const std::string& user_,
-                         const std::string& password_)
-    : host(host_), port(port_), dbname(dbname_), user(user_), password(password_) {}
+                         const std::string& password_,
+                         const std::vector<std::string>& replicas_,
+                         const std::string& readRouting_,
+                         const std::vector<std::string>& shards_)
+    : host(host_), port(port_), dbname(dbname_), user(user_), password(password_),
+      replicas(replicas_), readRouting(readRouting_), shards(shards_) {}
+
+void Application::splitEndpoint(const std::string& endpoint, std::string& endpointHost, std::string& endpointPort) {
+    std::string::size_type colon = endpoint.rfind(':');
+    endpointHost = endpoint.substr(0, colon);
+    endpointPort = colon == std::string::npos ? "5432" : endpoint.substr(colon + 1);
+}
 
 void Application::displayUsage() const {
     std::cout << "Employee Management System - Usage:" << std::endl;
@@ -33,6 +45,52 @@ void Application::displayUsage() const {
     std::cout << std::endl;
     std::cout << "  6 - Optimize database and measure improvement" << std::endl;
     std::cout << "      Example: ./myApp 6" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  7 - Run a command script over one connection (file or '-' for stdin)" << std::endl;
+    std::cout << "      Example: ./myApp 7 ops.txt" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  8 - Serve insert/query/list requests over a UNIX socket [socket] [workers]" << std::endl;
+    std::cout << "      Example: ./myApp 8 /tmp/sqlmanager.sock 4" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  9 - Send one request to a running server <socket> <request...>" << std::endl;
+    std::cout << "      Example: ./myApp 9 /tmp/sqlmanager.sock query Male F" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  10 - Compare server latency with the one-shot CLI [socket] [iterations]" << std::endl;
+    std::cout << "      Example: ./myApp 10 /tmp/sqlmanager.sock 20" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  11 - Open-loop read/write workload [read%] [ops/s] [seconds] [connections] [gender] [prefix]" << std::endl;
+    std::cout << "      Example: ./myApp 11 80 50 30 4 Male F" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  12 - Benchmark text decoding against binary row views [iterations]" << std::endl;
+    std::cout << "      Example: ./myApp 12 5" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  13 - Bulk load via UNLOGGED staging and deferred indexes [rows] [replace|append]" << std::endl;
+    std::cout << "      Example: ./myApp 13 1000000 replace" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  14 - Checkpointed fill that resumes after failures <load_id> [rows] [chunk_rows[,chunk_rows...]] [seed]" << std::endl;
+    std::cout << "      Example: ./myApp 14 refill-1 1000000 50000 42" << std::endl;
+    std::cout << "      Example: ./myApp 14 ladder 1000000 5000,50000,200000 42" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  15 - Health-check endpoints and show routed read latency [reads]" << std::endl;
+    std::cout << "      Example: ./myApp 15 20" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  16 - Sharded mode across Config::DB_SHARDS: create | insert <name> <date> <gender> | fill [rows] | list | query [gender] [prefix]" << std::endl;
+    std::cout << "      Example: ./myApp 16 query Male F" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  17 - Name search: substring <term> [limit] | fuzzy <term> [limit] [threshold] | bench [substring_term] [fuzzy_term]" << std::endl;
+    std::cout << "      Example: ./myApp 17 fuzzy Fitzgerlad 10" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  18 - Approximate count and age histogram vs exact [gender] [prefix] [sample_percent] [seed]" << std::endl;
+    std::cout << "      Example: ./myApp 18 Male F 1 42" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  19 - Server-side aggregate report vs client-side computation [parallel_workers]" << std::endl;
+    std::cout << "      Example: ./myApp 19 4" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  20 - Scale-ladder load/query benchmark (truncates employees) [sizes] [targeted_percent] [output_prefix]" << std::endl;
+    std::cout << "      Example: ./myApp 20 1000000,10000000,100000000 0.01 scale_ladder" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  21 - Columnar export: export <file> [gender] [prefix] | scan <file> [print_rows]" << std::endl;
+    std::cout << "      Example: ./myApp 21 export employees.col && ./myApp 21 scan employees.col 5" << std::endl;
     std::cout << std::string(80, '=') << std::endl;
 }
 
@@ -65,9 +123,6 @@ int Application::run(int argc, char* argv[]) {
     }
     
     try {
-        DatabaseManager db(host, port, dbname, user, password);
-        db.connect();
-        
         auto command = CommandFactory::createCommand(mode, args);
         
         if (!command) {
@@ -76,6 +131,32 @@ int Application::run(int argc, char* argv[]) {
             return 1;
         }
         
+        DatabaseManager db(host, port, dbname, user, password);
+        if (command->requiresConnection()) {
+            db.connect();
+            
+            if (!replicas.empty()) {
+                db.enableReadRouting(host + ":" + port, readRouting);
+                for (const auto& endpoint : replicas) {
+                    std::string replicaHost, replicaPort;
+                    splitEndpoint(endpoint, replicaHost, replicaPort);
+                    db.addReadReplica(endpoint, std::make_unique<DatabaseManager>(
+                        replicaHost, replicaPort, dbname, user, password));
+                }
+            }
+        }
+        
+        if (!shards.empty()) {
+            auto shardSet = std::make_unique<ShardedDatabase>();
+            for (const auto& endpoint : shards) {
+                std::string shardHost, shardPort;
+                splitEndpoint(endpoint, shardHost, shardPort);
+                shardSet->addShard(endpoint, std::make_unique<DatabaseManager>(
+                    shardHost, shardPort, dbname, user, password));
+            }
+            db.setShards(std::move(shardSet));
+        }
+        
         std::cout << "Executing: " << command->getDescription() << std::endl;
         std::cout << std::string(80, '=') << std::endl;
         command->execute(db);
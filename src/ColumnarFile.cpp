@@ -0,0 +1,216 @@
+#include "ColumnarFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const std::size_t COLUMN_ALIGNMENT = 8;
+    
+    std::uint64_t alignUp(std::uint64_t offset) {
+        return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+    }
+    
+    // Appends raw bytes to buffer, preceded by zero padding up to the alignment
+    template <typename T>
+    std::uint64_t appendColumn(std::string& buffer, const T* values, std::size_t count) {
+        buffer.resize(alignUp(buffer.size()), '\0');
+        std::uint64_t offset = buffer.size();
+        buffer.append(reinterpret_cast<const char*>(values), count * sizeof(T));
+        return offset;
+    }
+}
+
+ColumnarWriter::ColumnarWriter(const std::string& path, std::uint32_t rowGroupRows_)
+    : out(path, std::ios::binary | std::ios::trunc), rowGroupRows(rowGroupRows_), totalRows(0), finished(false) {
+    if (!out) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    ColumnarFormat::FileHeader header{};
+    std::memcpy(header.magic, ColumnarFormat::MAGIC, sizeof(header.magic));
+    header.version = ColumnarFormat::VERSION;
+    header.byteOrderMark = ColumnarFormat::BYTE_ORDER_MARK;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    codes.reserve(rowGroupRows);
+    birthDays.reserve(rowGroupRows);
+    ages.reserve(rowGroupRows);
+    nameOffsets.reserve(rowGroupRows + 1);
+    nameOffsets.push_back(0);
+}
+
+void ColumnarWriter::append(const EmployeeView& employee) {
+    auto code = genderCodes.find(std::string(employee.gender));
+    if (code == genderCodes.end()) {
+        if (genderDict.size() > 0xFF) {
+            throw std::runtime_error("Too many distinct gender values for a uint8 dictionary");
+        }
+        code = genderCodes.emplace(std::string(employee.gender), static_cast<std::uint8_t>(genderDict.size())).first;
+        genderDict.emplace_back(employee.gender);
+    }
+    codes.push_back(code->second);
+    birthDays.push_back(employee.birthDays);
+    ages.push_back(static_cast<std::uint8_t>(std::clamp(employee.age, 0, 0xFF)));
+    nameData.append(employee.fullName.data(), employee.fullName.size());
+    nameOffsets.push_back(static_cast<std::uint32_t>(nameData.size()));
+    
+    if (codes.size() >= rowGroupRows) {
+        flushRowGroup();
+    }
+}
+
+void ColumnarWriter::append(const EmployeeResultSet& batch) {
+    for (const auto& employee : batch) {
+        append(employee);
+    }
+}
+
+void ColumnarWriter::flushRowGroup() {
+    if (codes.empty()) {
+        return;
+    }
+    
+    ColumnarFormat::RowGroupHeader header{};
+    header.rows = static_cast<std::uint32_t>(codes.size());
+    header.genderEntries = static_cast<std::uint32_t>(genderDict.size());
+    
+    std::string group(sizeof(header), '\0');
+    
+    std::vector<std::uint32_t> dictOffsets{0};
+    std::string dictData;
+    for (const auto& entry : genderDict) {
+        dictData += entry;
+        dictOffsets.push_back(static_cast<std::uint32_t>(dictData.size()));
+    }
+    header.genderDictOffset = appendColumn(group, dictOffsets.data(), dictOffsets.size());
+    group += dictData;
+    header.genderCodesOffset = appendColumn(group, codes.data(), codes.size());
+    header.birthDaysOffset = appendColumn(group, birthDays.data(), birthDays.size());
+    header.agesOffset = appendColumn(group, ages.data(), ages.size());
+    header.nameOffsetsOffset = appendColumn(group, nameOffsets.data(), nameOffsets.size());
+    header.nameDataOffset = appendColumn(group, nameData.data(), nameData.size());
+    group.resize(alignUp(group.size()), '\0');
+    header.size = group.size();
+    std::memcpy(&group[0], &header, sizeof(header));
+    
+    groupOffsets.push_back(static_cast<std::uint64_t>(out.tellp()));
+    out.write(group.data(), static_cast<std::streamsize>(group.size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write row group");
+    }
+    totalRows += header.rows;
+    
+    // The dictionary restarts with every row group, so each group is self-contained
+    genderDict.clear();
+    genderCodes.clear();
+    codes.clear();
+    birthDays.clear();
+    ages.clear();
+    nameOffsets.assign(1, 0);
+    nameData.clear();
+}
+
+void ColumnarWriter::finish() {
+    if (finished) {
+        return;
+    }
+    flushRowGroup();
+    
+    ColumnarFormat::FileFooter footer{};
+    footer.rowGroupCount = groupOffsets.size();
+    footer.totalRows = totalRows;
+    footer.indexOffset = static_cast<std::uint64_t>(out.tellp());
+    std::memcpy(footer.magic, ColumnarFormat::MAGIC, sizeof(footer.magic));
+    
+    out.write(reinterpret_cast<const char*>(groupOffsets.data()),
+              static_cast<std::streamsize>(groupOffsets.size() * sizeof(std::uint64_t)));
+    out.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write columnar file footer");
+    }
+    finished = true;
+}
+
+ColumnarReader::ColumnarReader(const std::string& path)
+    : fd(-1), data(nullptr), fileSize(0), footer(nullptr), groupIndex(nullptr) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 ||
+        static_cast<std::size_t>(info.st_size) < sizeof(ColumnarFormat::FileHeader) + sizeof(ColumnarFormat::FileFooter)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a columnar employee file");
+    }
+    fileSize = static_cast<std::size_t>(info.st_size);
+    
+    void* mapped = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map " + path);
+    }
+    data = static_cast<const char*>(mapped);
+    // Scans read every column front to back
+    ::madvise(mapped, fileSize, MADV_SEQUENTIAL);
+    
+    auto header = reinterpret_cast<const ColumnarFormat::FileHeader*>(data);
+    footer = reinterpret_cast<const ColumnarFormat::FileFooter*>(data + fileSize - sizeof(ColumnarFormat::FileFooter));
+    std::string error;
+    if (std::memcmp(header->magic, ColumnarFormat::MAGIC, sizeof(header->magic)) != 0 ||
+        std::memcmp(footer->magic, ColumnarFormat::MAGIC, sizeof(footer->magic)) != 0) {
+        error = path + " is not a complete columnar employee file";
+    } else if (header->version != ColumnarFormat::VERSION) {
+        error = path + " has unsupported format version " + std::to_string(header->version);
+    } else if (header->byteOrderMark != ColumnarFormat::BYTE_ORDER_MARK) {
+        error = path + " was written on a machine with a different byte order";
+    } else if (footer->indexOffset + footer->rowGroupCount * sizeof(std::uint64_t) + sizeof(ColumnarFormat::FileFooter) != fileSize) {
+        error = path + " has a corrupt row group index";
+    }
+    if (!error.empty()) {
+        ::munmap(mapped, fileSize);
+        ::close(fd);
+        throw std::runtime_error(error);
+    }
+    groupIndex = reinterpret_cast<const std::uint64_t*>(data + footer->indexOffset);
+}
+
+ColumnarReader::~ColumnarReader() {
+    ::munmap(const_cast<char*>(data), fileSize);
+    ::close(fd);
+}
+
+ColumnarReader::RowGroup ColumnarReader::rowGroup(std::size_t index) const {
+    if (index >= rowGroupCount()) {
+        throw std::out_of_range("Row group index out of range");
+    }
+    return RowGroup(data + groupIndex[index]);
+}
+
+ColumnarReader::RowGroup::RowGroup(const char* base_)
+    : base(base_), header(reinterpret_cast<const ColumnarFormat::RowGroupHeader*>(base_)) {}
+
+std::string_view ColumnarReader::RowGroup::genderEntry(std::uint8_t code) const {
+    const std::uint32_t* offsets = column<std::uint32_t>(header->genderDictOffset);
+    const char* bytes = reinterpret_cast<const char*>(offsets + header->genderEntries + 1);
+    return std::string_view(bytes + offsets[code], offsets[code + 1] - offsets[code]);
+}
+
+std::string_view ColumnarReader::RowGroup::fullName(std::size_t row) const {
+    const std::uint32_t* offsets = column<std::uint32_t>(header->nameOffsetsOffset);
+    return std::string_view(column<char>(header->nameDataOffset) + offsets[row], offsets[row + 1] - offsets[row]);
+}
+
+EmployeeView ColumnarReader::RowGroup::operator[](std::size_t row) const {
+    EmployeeView view;
+    view.fullName = fullName(row);
+    view.birthDays = birthDays()[row];
+    view.gender = genderEntry(genderCodes()[row]);
+    view.age = ages()[row];
+    return view;
+}
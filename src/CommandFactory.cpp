@@ -1,6 +1,9 @@
 #include "CommandFactory.h"
 #include "Commands.h"
+#include "LocalProtocol.h"
 #include <iostream>
+#include <sstream>
+#include <algorithm>
 
 std::unique_ptr<ICommand> CommandFactory::createCommand(int mode, const std::vector<std::string>& args) {
     switch (mode) {
@@ -27,8 +30,299 @@ std::unique_ptr<ICommand> CommandFactory::createCommand(int mode, const std::vec
         case 6:
             return std::make_unique<OptimizeDatabaseCommand>();
             
+        case 7:
+            return std::make_unique<ScriptCommand>(args.empty() ? "-" : args[0]);
+            
+        case 8: {
+            std::string socketPath = args.size() > 0 ? args[0] : LocalProtocol::DEFAULT_SOCKET_PATH;
+            int workers = 4;
+            if (args.size() > 1) {
+                try {
+                    workers = std::stoi(args[1]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid worker count: " << args[1] << std::endl;
+                    return nullptr;
+                }
+            }
+            return std::make_unique<ServeCommand>(socketPath, workers);
+        }
+            
+        case 9:
+            if (args.size() < 2) {
+                std::cerr << "Error: Mode 9 requires arguments: <socket> <request...>" << std::endl;
+                std::cerr << "Example: myApp 9 /tmp/sqlmanager.sock query Male F" << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<ClientCommand>(args[0],
+                std::vector<std::string>(args.begin() + 1, args.end()));
+            
+        case 10: {
+            std::string socketPath = args.size() > 0 ? args[0] : LocalProtocol::DEFAULT_SOCKET_PATH;
+            int iterations = 20;
+            if (args.size() > 1) {
+                try {
+                    iterations = std::stoi(args[1]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid iteration count: " << args[1] << std::endl;
+                    return nullptr;
+                }
+            }
+            return std::make_unique<ServerBenchmarkCommand>(socketPath, iterations);
+        }
+            
+        case 11: {
+            WorkloadSettings settings;
+            try {
+                if (args.size() > 0) settings.readPercent = std::stoi(args[0]);
+                if (args.size() > 1) settings.targetRate = std::stod(args[1]);
+                if (args.size() > 2) settings.durationSeconds = std::stoi(args[2]);
+                if (args.size() > 3) settings.concurrency = std::stoi(args[3]);
+            } catch (...) {
+                std::cerr << "Error: Mode 11 arguments: [read_percent] [ops_per_sec] [seconds] [connections] [gender] [prefix]" << std::endl;
+                return nullptr;
+            }
+            if (args.size() > 4) settings.gender = args[4];
+            if (args.size() > 5) settings.lastNamePrefix = args[5];
+            return std::make_unique<WorkloadCommand>(settings);
+        }
+            
+        case 12: {
+            int iterations = 5;
+            if (args.size() > 0) {
+                try {
+                    iterations = std::stoi(args[0]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid iteration count: " << args[0] << std::endl;
+                    return nullptr;
+                }
+            }
+            return std::make_unique<DecodeBenchmarkCommand>(iterations);
+        }
+            
+        case 13: {
+            int rows = 1000000;
+            if (args.size() > 0) {
+                try {
+                    rows = std::stoi(args[0]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid row count: " << args[0] << std::endl;
+                    return nullptr;
+                }
+            }
+            bool append = args.size() > 1 && args[1] == "append";
+            if (args.size() > 1 && !append && args[1] != "replace") {
+                std::cerr << "Error: Mode 13 load mode must be 'replace' or 'append'" << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<BulkLoadCommand>(rows, append);
+        }
+            
+        case 14: {
+            if (args.empty()) {
+                std::cerr << "Error: Mode 14 requires arguments: <load_id> [rows] [chunk_rows] [seed]" << std::endl;
+                std::cerr << "Example: myApp 14 refill-1 1000000 50000 42" << std::endl;
+                return nullptr;
+            }
+            long long rows = 1000000;
+            std::vector<int> chunkSizes = {50000};
+            long long seed = 42;
+            try {
+                if (args.size() > 1) rows = std::stoll(args[1]);
+                if (args.size() > 2) {
+                    // A comma-separated list runs one load per chunk size
+                    chunkSizes.clear();
+                    std::stringstream list(args[2]);
+                    std::string item;
+                    while (std::getline(list, item, ',')) {
+                        chunkSizes.push_back(std::stoi(item));
+                    }
+                }
+                if (args.size() > 3) seed = std::stoll(args[3]);
+            } catch (...) {
+                std::cerr << "Error: Invalid numeric argument for mode 14" << std::endl;
+                return nullptr;
+            }
+            if (rows < 0 || chunkSizes.empty() ||
+                *std::min_element(chunkSizes.begin(), chunkSizes.end()) < 1) {
+                std::cerr << "Error: Mode 14 needs rows >= 0 and chunk_rows >= 1" << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<ResumableFillCommand>(args[0], rows, chunkSizes, seed);
+        }
+            
+        case 15: {
+            int reads = 20;
+            if (args.size() > 0) {
+                try {
+                    reads = std::stoi(args[0]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid read count: " << args[0] << std::endl;
+                    return nullptr;
+                }
+            }
+            return std::make_unique<EndpointStatsCommand>(reads);
+        }
+            
+        case 16: {
+            if (args.empty()) {
+                std::cerr << "Error: Mode 16 requires an action: create | insert | fill | list | query" << std::endl;
+                return nullptr;
+            }
+            const std::string& action = args[0];
+            std::vector<std::string> rest(args.begin() + 1, args.end());
+            if (action == "insert" && rest.size() < 3) {
+                std::cerr << "Error: Sharded insert requires 3 arguments: <full_name> <birth_date> <gender>" << std::endl;
+                return nullptr;
+            }
+            if (action == "fill" && !rest.empty()) {
+                try {
+                    std::stoi(rest[0]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid row count: " << rest[0] << std::endl;
+                    return nullptr;
+                }
+            }
+            if (action != "create" && action != "insert" && action != "fill" &&
+                action != "list" && action != "query") {
+                std::cerr << "Error: Unknown sharded action: " << action << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<ShardedCommand>(action, rest);
+        }
+            
+        case 17: {
+            if (args.empty()) {
+                std::cerr << "Error: Mode 17 requires an action: substring | fuzzy | bench" << std::endl;
+                return nullptr;
+            }
+            const std::string& action = args[0];
+            if (action == "bench") {
+                std::string substringTerm = args.size() > 1 ? args[1] : "gerald";
+                std::string fuzzyTerm = args.size() > 2 ? args[2] : "Fitzgerlad";
+                return std::make_unique<NameSearchBenchmarkCommand>(substringTerm, fuzzyTerm);
+            }
+            if (action != "substring" && action != "fuzzy") {
+                std::cerr << "Error: Unknown search action: " << action << std::endl;
+                return nullptr;
+            }
+            if (args.size() < 2) {
+                std::cerr << "Error: Name search requires a search term" << std::endl;
+                return nullptr;
+            }
+            int limit = 20;
+            double threshold = DatabaseManager::DEFAULT_FUZZY_THRESHOLD;
+            try {
+                if (args.size() > 2) {
+                    limit = std::stoi(args[2]);
+                }
+                if (args.size() > 3) {
+                    threshold = std::stod(args[3]);
+                }
+            } catch (...) {
+                std::cerr << "Error: Invalid limit or threshold" << std::endl;
+                return nullptr;
+            }
+            auto match = action == "fuzzy" ? DatabaseManager::NameMatch::FUZZY
+                                           : DatabaseManager::NameMatch::SUBSTRING;
+            return std::make_unique<NameSearchCommand>(match, args[1], limit, threshold);
+        }
+            
+        case 18: {
+            std::string gender = args.size() > 0 ? args[0] : "Male";
+            std::string prefix = args.size() > 1 ? args[1] : "F";
+            double percent = 1.0;
+            int seed = 42;
+            try {
+                if (args.size() > 2) {
+                    percent = std::stod(args[2]);
+                }
+                if (args.size() > 3) {
+                    seed = std::stoi(args[3]);
+                }
+            } catch (...) {
+                std::cerr << "Error: Invalid sampling percent or seed" << std::endl;
+                return nullptr;
+            }
+            if (percent <= 0.0 || percent > 100.0) {
+                std::cerr << "Error: Sampling percent must be in (0, 100]" << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<ApproximateQueryCommand>(gender, prefix, percent, seed);
+        }
+            
+        case 19: {
+            int workers = 4;
+            if (args.size() > 0) {
+                try {
+                    workers = std::stoi(args[0]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid worker count: " << args[0] << std::endl;
+                    return nullptr;
+                }
+            }
+            return std::make_unique<AggregateReportCommand>(workers);
+        }
+            
+        case 20: {
+            std::vector<long long> sizes = {1000000, 10000000, 100000000};
+            double targetedPercent = 0.01;
+            std::string outputPrefix = args.size() > 2 ? args[2] : "scale_ladder";
+            try {
+                if (args.size() > 0) {
+                    sizes.clear();
+                    std::stringstream list(args[0]);
+                    std::string item;
+                    while (std::getline(list, item, ',')) {
+                        sizes.push_back(std::stoll(item));
+                    }
+                }
+                if (args.size() > 1) {
+                    targetedPercent = std::stod(args[1]);
+                }
+            } catch (...) {
+                std::cerr << "Error: Invalid sizes or targeted percent" << std::endl;
+                return nullptr;
+            }
+            if (sizes.empty() || !std::is_sorted(sizes.begin(), sizes.end()) || sizes.front() <= 0 ||
+                std::adjacent_find(sizes.begin(), sizes.end()) != sizes.end()) {
+                std::cerr << "Error: Sizes must be positive and strictly increasing, e.g. 1000000,10000000" << std::endl;
+                return nullptr;
+            }
+            if (targetedPercent < 0.0 || targetedPercent > 100.0) {
+                std::cerr << "Error: Targeted percent must be in [0, 100]" << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<ScaleLadderCommand>(sizes, targetedPercent / 100.0, outputPrefix);
+        }
+            
+        case 21: {
+            if (args.size() < 2 || (args[0] != "export" && args[0] != "scan")) {
+                std::cerr << "Error: Mode 21 requires: export <file> [gender] [prefix] | scan <file> [print_rows]" << std::endl;
+                return nullptr;
+            }
+            if (args[0] == "export") {
+                if (args.size() == 3) {
+                    std::cerr << "Error: Export by criteria requires both <gender> and <prefix>" << std::endl;
+                    return nullptr;
+                }
+                std::string gender = args.size() > 3 ? args[2] : "";
+                std::string prefix = args.size() > 3 ? args[3] : "";
+                return std::make_unique<ColumnarExportCommand>(args[1], gender, prefix);
+            }
+            int printRows = 0;
+            if (args.size() > 2) {
+                try {
+                    printRows = std::stoi(args[2]);
+                } catch (...) {
+                    std::cerr << "Error: Invalid row count: " << args[2] << std::endl;
+                    return nullptr;
+                }
+            }
+            return std::make_unique<ColumnarScanCommand>(args[1], printRows);
+        }
+            
         default:
-            std::cerr << "Error: Invalid mode. Please use mode 1-6." << std::endl;
+            std::cerr << "Error: Invalid mode. Please use mode 1-21." << std::endl;
             return nullptr;
     }
 }
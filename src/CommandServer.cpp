@@ -0,0 +1,342 @@
+#include "CommandServer.h"
+#include "Commands.h"
+#include "DatabaseManager.h"
+#include "LocalProtocol.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    volatile std::sig_atomic_t stopRequested = 0;
+    
+    void onStopSignal(int) {
+        stopRequested = 1;
+    }
+    
+    void setNonBlocking(int fd) {
+        int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+    
+    struct Client {
+        int fd;
+        std::string input;
+        std::string output;
+        std::size_t outputOffset = 0;
+        bool busy = false;
+        bool closed = false;
+    };
+    
+    template <typename Rows>
+    std::string formatRows(const Rows& rows) {
+        std::string response = "OK " + std::to_string(rows.size()) + "\n";
+        response.reserve(rows.size() * 64);
+        for (const auto& row : rows) {
+            response.append(std::get<0>(row)).push_back('\t');
+            response.append(std::get<1>(row)).push_back('\t');
+            response.append(std::get<2>(row)).push_back('\t');
+            response.append(std::to_string(std::get<3>(row))).push_back('\n');
+        }
+        return response;
+    }
+}
+
+CommandServer::CommandServer(const std::string& socketPath_, int workerCount_)
+    : socketPath(socketPath_), workerCount(workerCount_ > 0 ? workerCount_ : 1), stopping(false) {
+    if (::pipe(wakePipe) < 0) {
+        throw std::runtime_error(std::string("pipe() failed: ") + std::strerror(errno));
+    }
+    setNonBlocking(wakePipe[0]);
+    setNonBlocking(wakePipe[1]);
+}
+
+CommandServer::~CommandServer() {
+    ::close(wakePipe[0]);
+    ::close(wakePipe[1]);
+}
+
+std::string CommandServer::handleRequest(DatabaseManager& db, const std::string& request) {
+    try {
+        auto tokens = ScriptCommand::tokenize(request);
+        if (tokens.empty()) {
+            return "ERR empty request\n";
+        }
+        
+        const std::string& op = tokens[0];
+        if (op == "ping") {
+            return "OK 0\n";
+        }
+        
+        // A session lost by an earlier request is replaced here; while the
+        // server stays unreachable every request fails with ERR instead of
+        // running against a closed connection
+        if (!db.isConnected()) {
+            try {
+                db.reconnect();
+            } catch (const std::exception& e) {
+                return std::string("ERR not connected: ") + e.what() + "\n";
+            }
+        }
+        
+        if (op == "insert" && tokens.size() == 4) {
+            db.insertEmployee(tokens[1], tokens[2], tokens[3]);
+            return "OK 1\n";
+        }
+        if (op == "query" && tokens.size() == 3) {
+            return formatRows(db.getEmployeesByCriteria(tokens[1], tokens[2]));
+        }
+        if (op == "list" && tokens.size() == 1) {
+            return formatRows(db.getAllEmployees());
+        }
+        return "ERR unknown request: " + request + "\n";
+    } catch (const pqxx::broken_connection& e) {
+        // Drop the dead session; the next request reconnects before it runs
+        db.disconnect();
+        return std::string("ERR connection lost: ") + e.what() + "\n";
+    } catch (const std::exception& e) {
+        return std::string("ERR ") + e.what() + "\n";
+    }
+}
+
+void CommandServer::submit(unsigned long clientId, std::string request) {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobs.push_back({clientId, std::move(request)});
+    }
+    jobReady.notify_one();
+}
+
+void CommandServer::wakeEventLoop() {
+    char byte = 1;
+    // A full pipe already guarantees a pending wake-up
+    (void)!::write(wakePipe[1], &byte, 1);
+}
+
+void CommandServer::workerLoop(DatabaseManager& db) {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        
+        std::string response = handleRequest(db, job.request);
+        
+        {
+            std::lock_guard<std::mutex> lock(replyMutex);
+            replies.push_back({job.clientId, std::move(response)});
+        }
+        wakeEventLoop();
+    }
+}
+
+void CommandServer::run(DatabaseManager& primary) {
+    std::vector<std::unique_ptr<DatabaseManager>> extraConnections;
+    std::vector<DatabaseManager*> pool{&primary};
+    for (int i = 1; i < workerCount; ++i) {
+        extraConnections.push_back(std::make_unique<DatabaseManager>(primary.getConnectionString()));
+        extraConnections.back()->connect();
+        pool.push_back(extraConnections.back().get());
+    }
+    for (auto* db : pool) {
+        try {
+            db->prepareStatements();
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: could not prepare statements (" << e.what()
+                      << "), they will be prepared on first use" << std::endl;
+        }
+    }
+    
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socketPath);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
+    }
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listenFd, SOMAXCONN) < 0) {
+        int error = errno;
+        ::close(listenFd);
+        throw std::runtime_error("Cannot listen on " + socketPath + ": " + std::strerror(error));
+    }
+    setNonBlocking(listenFd);
+    
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+    stopRequested = 0;
+    
+    std::vector<std::thread> workers;
+    for (auto* db : pool) {
+        workers.emplace_back(&CommandServer::workerLoop, this, std::ref(*db));
+    }
+    
+    std::cout << "Listening on " << socketPath << " with " << pool.size()
+              << " pooled connections (Ctrl+C to stop)" << std::endl;
+    
+    std::map<unsigned long, Client> clients;
+    unsigned long nextClientId = 1;
+    std::vector<pollfd> fds;
+    std::vector<unsigned long> fdOwners;
+    
+    // Hands the next complete frame of an idle client to the worker pool
+    auto dispatch = [this](unsigned long id, Client& client) {
+        if (client.busy || client.input.size() < LocalProtocol::HEADER_SIZE) {
+            return;
+        }
+        std::uint32_t length = LocalProtocol::decodeHeader(
+            reinterpret_cast<const unsigned char*>(client.input.data()));
+        if (length > LocalProtocol::MAX_REQUEST_SIZE) {
+            client.closed = true;
+            return;
+        }
+        if (client.input.size() < LocalProtocol::HEADER_SIZE + length) {
+            return;
+        }
+        std::string request = client.input.substr(LocalProtocol::HEADER_SIZE, length);
+        client.input.erase(0, LocalProtocol::HEADER_SIZE + length);
+        client.busy = true;
+        submit(id, std::move(request));
+    };
+    
+    while (!stopRequested) {
+        fds.clear();
+        fdOwners.clear();
+        fds.push_back({wakePipe[0], POLLIN, 0});
+        fds.push_back({listenFd, POLLIN, 0});
+        for (auto& entry : clients) {
+            short events = POLLIN;
+            if (entry.second.outputOffset < entry.second.output.size()) {
+                events |= POLLOUT;
+            }
+            fds.push_back({entry.second.fd, events, 0});
+            fdOwners.push_back(entry.first);
+        }
+        
+        int ready = ::poll(fds.data(), fds.size(), 500);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            char drain[256];
+            while (::read(wakePipe[0], drain, sizeof(drain)) > 0) { }
+            
+            std::deque<Reply> completed;
+            {
+                std::lock_guard<std::mutex> lock(replyMutex);
+                completed.swap(replies);
+            }
+            for (auto& reply : completed) {
+                auto it = clients.find(reply.clientId);
+                if (it == clients.end()) {
+                    continue;
+                }
+                LocalProtocol::appendFrame(it->second.output, reply.response);
+                it->second.busy = false;
+                dispatch(it->first, it->second);
+            }
+        }
+        
+        if (fds[1].revents & POLLIN) {
+            while (true) {
+                int clientFd = ::accept(listenFd, nullptr, nullptr);
+                if (clientFd < 0) {
+                    break;
+                }
+                setNonBlocking(clientFd);
+                Client client;
+                client.fd = clientFd;
+                clients.emplace(nextClientId++, std::move(client));
+            }
+        }
+        
+        for (std::size_t i = 2; i < fds.size(); ++i) {
+            auto it = clients.find(fdOwners[i - 2]);
+            Client& client = it->second;
+            
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                char buffer[4096];
+                while (true) {
+                    ssize_t received = ::read(client.fd, buffer, sizeof(buffer));
+                    if (received > 0) {
+                        client.input.append(buffer, static_cast<std::size_t>(received));
+                        continue;
+                    }
+                    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                        client.closed = true;
+                    }
+                    if (received < 0 && errno == EINTR) continue;
+                    break;
+                }
+                dispatch(it->first, client);
+            }
+            
+            if ((fds[i].revents & POLLOUT) && !client.closed) {
+                while (client.outputOffset < client.output.size()) {
+                    ssize_t written = ::write(client.fd, client.output.data() + client.outputOffset,
+                                              client.output.size() - client.outputOffset);
+                    if (written <= 0) {
+                        if (written < 0 && errno == EINTR) continue;
+                        if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                            client.closed = true;
+                        }
+                        break;
+                    }
+                    client.outputOffset += static_cast<std::size_t>(written);
+                }
+                if (client.outputOffset == client.output.size()) {
+                    client.output.clear();
+                    client.outputOffset = 0;
+                }
+            }
+        }
+        
+        // Replies for clients that disconnected mid-request are dropped on arrival
+        for (auto it = clients.begin(); it != clients.end();) {
+            if (it->second.closed) {
+                ::close(it->second.fd);
+                it = clients.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    std::cout << "Shutting down server..." << std::endl;
+    stopping = true;
+    jobReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& entry : clients) {
+        ::close(entry.second.fd);
+    }
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+}
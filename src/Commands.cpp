@@ -1,8 +1,27 @@
 #include "Commands.h"
 #include "IDataGenerator.h"
+#include "CommandFactory.h"
+#include "CommandServer.h"
+#include "LocalProtocol.h"
+#include "ReplicaRouter.h"
+#include "ShardedDatabase.h"
+#include "ColumnarFile.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <sstream>
+#include <map>
+#include <set>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <thread>
 
 
 void CreateTableCommand::execute(DatabaseManager& dbManager) {
@@ -28,7 +47,7 @@ void DisplayEmployeesCommand::execute(DatabaseManager& dbManager) {
     std::cout << "Displaying all employees (unique by Full Name + Birth Date, sorted by Full Name):" << std::endl;
     std::cout << std::string(100, '-') << std::endl;
     
-    auto employees = dbManager.getAllEmployees();
+    auto employees = dbManager.getAllEmployeeViews();
     
     if (employees.empty()) {
         std::cout << "No employees found in database." << std::endl;
@@ -38,11 +57,12 @@ void DisplayEmployeesCommand::execute(DatabaseManager& dbManager) {
     std::cout << "Total employees: " << employees.size() << std::endl;
     std::cout << std::string(100, '-') << std::endl;
     
+    char dateBuffer[EmployeeView::DATE_BUFFER_SIZE];
     for (const auto& emp : employees) {
-        std::cout << "Full Name: " << std::get<0>(emp) << std::endl;
-        std::cout << "Birth Date: " << std::get<1>(emp) << std::endl;
-        std::cout << "Gender: " << std::get<2>(emp) << std::endl;
-        std::cout << "Age: " << std::get<3>(emp) << " years" << std::endl;
+        std::cout << "Full Name: " << emp.fullName << std::endl;
+        std::cout << "Birth Date: " << emp.birthDate(dateBuffer) << std::endl;
+        std::cout << "Gender: " << emp.gender << std::endl;
+        std::cout << "Age: " << emp.age << " years" << std::endl;
         std::cout << std::string(100, '-') << std::endl;
     }
 }
@@ -73,9 +93,12 @@ void QueryEmployeesCommand::execute(DatabaseManager& dbManager) {
     std::cout << "Querying employees: Gender = Male, Surname starts with 'F'" << std::endl;
     std::cout << std::string(100, '-') << std::endl;
     
+    // The binary session and its prepared statement are set up outside the timer
+    dbManager.prepareViewStatements();
+    
     auto start = std::chrono::high_resolution_clock::now();
     
-    auto employees = dbManager.getEmployeesByCriteria("Male", "F");
+    auto employees = dbManager.getEmployeeViewsByCriteria("Male", "F");
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -87,11 +110,12 @@ void QueryEmployeesCommand::execute(DatabaseManager& dbManager) {
     // Display all results
     if (!employees.empty()) {
         std::cout << "Displaying all " << employees.size() << " results:" << std::endl;
-        for (size_t i = 0; i < employees.size(); ++i) {
-            std::cout << "Full Name: " << std::get<0>(employees[i]) << std::endl;
-            std::cout << "Birth Date: " << std::get<1>(employees[i]) << std::endl;
-            std::cout << "Gender: " << std::get<2>(employees[i]) << std::endl;
-            std::cout << "Age: " << std::get<3>(employees[i]) << " years" << std::endl;
+        char dateBuffer[EmployeeView::DATE_BUFFER_SIZE];
+        for (const auto& emp : employees) {
+            std::cout << "Full Name: " << emp.fullName << std::endl;
+            std::cout << "Birth Date: " << emp.birthDate(dateBuffer) << std::endl;
+            std::cout << "Gender: " << emp.gender << std::endl;
+            std::cout << "Age: " << emp.age << " years" << std::endl;
             std::cout << std::string(100, '-') << std::endl;
         }
     }
@@ -146,7 +170,1276 @@ void OptimizeDatabaseCommand::execute(DatabaseManager& dbManager) {
     std::cout << "\nOptimization techniques applied:" << std::endl;
     std::cout << "  1. Partial Index: Index only for Male employees with surname 'F'" << std::endl;
     std::cout << "  2. Covering Index: Includes all query columns to avoid table lookups" << std::endl;
-    std::cout << "  3. VACUUM ANALYZE: Reclaimed storage and updated statistics" << std::endl;
-    std::cout << "  4. Increased work_mem: Better memory for sorting operations (256MB)" << std::endl;
+    std::cout << "  3. Trigram Index: GIN pg_trgm index for substring and fuzzy name search" << std::endl;
+    std::cout << "  4. VACUUM ANALYZE: Reclaimed storage and updated statistics" << std::endl;
+    std::cout << "  5. Increased work_mem: Better memory for sorting operations (256MB)" << std::endl;
+}
+
+ScriptCommand::ScriptCommand(const std::string& path) : scriptPath(path) {}
+
+std::vector<std::string> ScriptCommand::tokenize(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::string current;
+    bool inQuotes = false;
+    bool hasToken = false;
+    
+    for (char c : line) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            hasToken = true;
+        } else if (!inQuotes && (c == ' ' || c == '\t' || c == '\r')) {
+            if (hasToken) {
+                tokens.push_back(current);
+                current.clear();
+                hasToken = false;
+            }
+        } else {
+            current.push_back(c);
+            hasToken = true;
+        }
+    }
+    
+    if (inQuotes) {
+        throw std::runtime_error("Unterminated quote in: " + line);
+    }
+    if (hasToken) {
+        tokens.push_back(current);
+    }
+    
+    return tokens;
+}
+
+void ScriptCommand::execute(DatabaseManager& dbManager) {
+    std::ifstream file;
+    if (scriptPath != "-") {
+        file.open(scriptPath);
+        if (!file) {
+            throw std::runtime_error("Cannot open script file: " + scriptPath);
+        }
+    }
+    std::istream& in = (scriptPath == "-") ? std::cin : file;
+    
+    std::cout << "Running script from " << (scriptPath == "-" ? "stdin" : scriptPath)
+              << " over a single connection" << std::endl;
+    
+    std::vector<std::pair<std::string, long long>> timings;
+    auto scriptStart = std::chrono::high_resolution_clock::now();
+    
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        
+        auto tokens = tokenize(line);
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue;
+        }
+        
+        int mode;
+        try {
+            mode = std::stoi(tokens[0]);
+        } catch (...) {
+            throw std::runtime_error("Line " + std::to_string(lineNumber) + ": invalid mode '" + tokens[0] + "'");
+        }
+        if (mode == 7) {
+            throw std::runtime_error("Line " + std::to_string(lineNumber) + ": scripts cannot be nested");
+        }
+        
+        std::vector<std::string> args(tokens.begin() + 1, tokens.end());
+        auto command = CommandFactory::createCommand(mode, args);
+        if (!command) {
+            throw std::runtime_error("Line " + std::to_string(lineNumber) + ": failed to create command for mode " + tokens[0]);
+        }
+        
+        std::cout << std::string(80, '=') << std::endl;
+        std::cout << "[" << lineNumber << "] Executing: " << command->getDescription() << std::endl;
+        std::cout << std::string(80, '-') << std::endl;
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        command->execute(dbManager);
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        
+        std::cout << "[" << lineNumber << "] Completed in " << duration.count() << " ms" << std::endl;
+        timings.emplace_back(line, duration.count());
+    }
+    
+    auto scriptEnd = std::chrono::high_resolution_clock::now();
+    auto total = std::chrono::duration_cast<std::chrono::milliseconds>(scriptEnd - scriptStart);
+    
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << "*** SCRIPT TIMINGS ***" << std::endl;
+    for (const auto& timing : timings) {
+        std::cout << std::setw(10) << timing.second << " ms  " << timing.first << std::endl;
+    }
+    std::cout << "Commands executed: " << timings.size() << std::endl;
+    std::cout << "Total script time: " << total.count() << " ms" << std::endl;
+}
+
+ServeCommand::ServeCommand(const std::string& socketPath, int workers)
+    : socketPath(socketPath), workers(workers) {}
+
+void ServeCommand::execute(DatabaseManager& dbManager) {
+    CommandServer server(socketPath, workers);
+    server.run(dbManager);
+}
+
+ClientCommand::ClientCommand(const std::string& socketPath, const std::vector<std::string>& request)
+    : socketPath(socketPath), request(request) {}
+
+void ClientCommand::execute(DatabaseManager&) {
+    std::string line = LocalProtocol::joinRequest(request.data(), request.data() + request.size());
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    int fd = LocalProtocol::connectTo(socketPath);
+    std::string response;
+    bool ok = LocalProtocol::writeFrame(fd, line) && LocalProtocol::readFrame(fd, response);
+    ::close(fd);
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    
+    if (!ok) {
+        throw std::runtime_error("Server closed the connection without a response");
+    }
+    
+    std::cout << response;
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << "Round trip: " << std::fixed << std::setprecision(3)
+              << duration.count() / 1000.0 << " ms" << std::endl;
+    
+    if (response.compare(0, 3, "ERR") == 0) {
+        throw std::runtime_error("Server returned an error");
+    }
+}
+
+namespace {
+    void printShardTimings(const std::vector<ShardedDatabase::ShardTiming>& timings) {
+        std::cout << std::left << std::setw(28) << "Shard" << std::right
+                  << std::setw(12) << "rows" << std::setw(12) << "ms" << std::endl;
+        for (const auto& timing : timings) {
+            std::cout << std::left << std::setw(28) << timing.name << std::right
+                      << std::setw(12) << timing.rows << std::fixed << std::setprecision(2)
+                      << std::setw(12) << timing.ms << std::endl;
+        }
+    }
+    
+    void printLatencyRow(const std::string& label, std::vector<double> samples) {
+        if (samples.empty()) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        auto percentile = [&samples](double p) {
+            std::size_t index = static_cast<std::size_t>(p * (samples.size() - 1) + 0.5);
+            return samples[index];
+        };
+        
+        std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << samples.front()
+                  << std::setw(12) << percentile(0.50)
+                  << std::setw(12) << percentile(0.99)
+                  << std::setw(12) << samples.back()
+                  << std::setw(12) << sum / samples.size() << std::endl;
+    }
+}
+
+ServerBenchmarkCommand::ServerBenchmarkCommand(const std::string& socketPath, int iterations)
+    : socketPath(socketPath), iterations(iterations > 0 ? iterations : 1) {}
+
+void ServerBenchmarkCommand::execute(DatabaseManager&) {
+    const std::string request = "query Male F";
+    
+    std::cout << "Benchmarking '" << request << "' (" << iterations << " iterations)" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::cout << "Server over " << socketPath << "..." << std::endl;
+    std::vector<double> serverSamples;
+    {
+        int fd = LocalProtocol::connectTo(socketPath);
+        std::string response;
+        
+        // Warm-up round trip so both paths are measured with hot server caches
+        if (!LocalProtocol::writeFrame(fd, request) || !LocalProtocol::readFrame(fd, response)) {
+            ::close(fd);
+            throw std::runtime_error("Server closed the connection during warm-up");
+        }
+        
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            if (!LocalProtocol::writeFrame(fd, request) || !LocalProtocol::readFrame(fd, response)) {
+                ::close(fd);
+                throw std::runtime_error("Server closed the connection");
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            serverSamples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        ::close(fd);
+    }
+    
+    // The one-shot path is the real CLI: process start, connect, mode 5, exit
+    std::cout << "One-shot CLI (mode 5, output discarded)..." << std::endl;
+    std::vector<double> cliSamples;
+    {
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        
+        char program[] = "/proc/self/exe";
+        char name[] = "SqlManager";
+        char mode[] = "5";
+        char* argv[] = {name, mode, nullptr};
+        
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            pid_t pid;
+            if (posix_spawn(&pid, program, &actions, nullptr, argv, environ) != 0) {
+                posix_spawn_file_actions_destroy(&actions);
+                throw std::runtime_error("Failed to spawn one-shot CLI");
+            }
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+            auto end = std::chrono::high_resolution_clock::now();
+            
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                posix_spawn_file_actions_destroy(&actions);
+                throw std::runtime_error("One-shot CLI run failed");
+            }
+            cliSamples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        posix_spawn_file_actions_destroy(&actions);
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "*** LATENCY (ms) ***" << std::endl;
+    std::cout << std::left << std::setw(22) << "Path" << std::right
+              << std::setw(12) << "min" << std::setw(12) << "p50"
+              << std::setw(12) << "p99" << std::setw(12) << "max"
+              << std::setw(12) << "avg" << std::endl;
+    printLatencyRow("Server (warm)", serverSamples);
+    printLatencyRow("One-shot CLI", cliSamples);
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+WorkloadCommand::WorkloadCommand(const WorkloadSettings& settings) : settings(settings) {}
+
+void WorkloadCommand::execute(DatabaseManager& dbManager) {
+    WorkloadGenerator generator(settings);
+    generator.run(dbManager);
+}
+
+DecodeBenchmarkCommand::DecodeBenchmarkCommand(int iterations) : iterations(iterations > 0 ? iterations : 1) {}
+
+void DecodeBenchmarkCommand::execute(DatabaseManager& dbManager) {
+    std::cout << "Decode benchmark: Gender = Male, Surname starts with 'F' (" << iterations << " iterations)" << std::endl;
+    std::cout << "Both paths compute the same aggregate (rows, name bytes, age sum, latest birth date)" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    // Warm up both sessions and the buffer cache
+    dbManager.getEmployeesByCriteria("Male", "F");
+    dbManager.getEmployeeViewsByCriteria("Male", "F");
+    
+    std::vector<double> textSamples;
+    std::vector<double> viewSamples;
+    std::size_t textRows = 0, viewRows = 0;
+    long long textChecksum = 0, viewChecksum = 0;
+    std::string textLatest, viewLatest;
+    
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto employees = dbManager.getEmployeesByCriteria("Male", "F");
+        long long checksum = 0;
+        std::string latest;
+        for (const auto& emp : employees) {
+            checksum += static_cast<long long>(std::get<0>(emp).size()) + std::get<3>(emp);
+            if (std::get<1>(emp) > latest) latest = std::get<1>(emp);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        textSamples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        textRows = employees.size();
+        textChecksum = checksum;
+        textLatest = latest;
+    }
+    
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto employees = dbManager.getEmployeeViewsByCriteria("Male", "F");
+        long long checksum = 0;
+        std::int32_t latest = std::numeric_limits<std::int32_t>::min();
+        for (const auto& emp : employees) {
+            checksum += static_cast<long long>(emp.fullName.size()) + emp.age;
+            latest = std::max(latest, emp.birthDays);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        viewSamples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        viewRows = employees.size();
+        viewChecksum = checksum;
+        if (!employees.empty()) {
+            char dateBuffer[EmployeeView::DATE_BUFFER_SIZE];
+            EmployeeView latestView{};
+            latestView.birthDays = latest;
+            viewLatest = std::string(latestView.birthDate(dateBuffer));
+        }
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "*** QUERY + DECODE TIME (ms) ***" << std::endl;
+    std::cout << std::left << std::setw(22) << "Path" << std::right
+              << std::setw(12) << "min" << std::setw(12) << "p50"
+              << std::setw(12) << "p99" << std::setw(12) << "max"
+              << std::setw(12) << "avg" << std::endl;
+    printLatencyRow("Text tuples (pqxx)", textSamples);
+    printLatencyRow("Binary row views", viewSamples);
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << "Rows: " << textRows << " (text) / " << viewRows << " (views)" << std::endl;
+    bool same = textRows == viewRows && textChecksum == viewChecksum && textLatest == viewLatest;
+    std::cout << "Aggregates " << (same ? "match" : "DIFFER") << " (latest birth date " << viewLatest << ")" << std::endl;
+    
+    double textBest = *std::min_element(textSamples.begin(), textSamples.end());
+    double viewBest = *std::min_element(viewSamples.begin(), viewSamples.end());
+    if (textRows > 0 && textBest > 0.0 && viewBest > 0.0) {
+        std::cout << "Throughput (best run): " << std::fixed << std::setprecision(0)
+                  << textRows / (textBest / 1000.0) << " rows/s (text) vs "
+                  << viewRows / (viewBest / 1000.0) << " rows/s (views)" << std::endl;
+    }
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+BulkLoadCommand::BulkLoadCommand(int rowCount, bool appendExisting)
+    : rowCount(rowCount > 0 ? rowCount : 1), appendExisting(appendExisting) {}
+
+void BulkLoadCommand::execute(DatabaseManager& dbManager) {
+    // Rows are generated in slices so the client never holds the full dataset
+    const int generationChunk = 100000;
+    
+    std::cout << "Bulk loading " << rowCount << " random + 100 targeted employees ("
+              << (appendExisting ? "keeping" : "replacing") << " existing rows)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    
+    // Baseline: the current refill path, mode 4 into the live table followed
+    // by mode 6. It refills employees in place, so it only runs with 'replace',
+    // whose result the bulk path then overwrites with the same number of rows.
+    long long baselineLoadMs = 0;
+    long long baselineIndexMs = 0;
+    if (!appendExisting) {
+        std::cout << "\nBaseline: mode 4 into employees with live indexes, then mode 6" << std::endl;
+        dbManager.truncateEmployees();
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        RandomDataGenerator randomGen;
+        dbManager.batchInsertEmployees(randomGen.generateEmployees(rowCount));
+        TargetedDataGenerator targetedGen("Male", 'F');
+        dbManager.batchInsertEmployees(targetedGen.generateEmployees(100));
+        auto indexStart = std::chrono::high_resolution_clock::now();
+        dbManager.dropIndex();
+        dbManager.createOptimizationIndex();
+        auto indexEnd = std::chrono::high_resolution_clock::now();
+        baselineLoadMs = std::chrono::duration_cast<std::chrono::milliseconds>(indexStart - loadStart).count();
+        baselineIndexMs = std::chrono::duration_cast<std::chrono::milliseconds>(indexEnd - indexStart).count();
+        std::cout << std::string(100, '=') << std::endl;
+    }
+    
+    std::vector<std::pair<std::string, long long>> phases;
+    auto timePhase = [&phases](const std::string& name, auto&& action) {
+        std::cout << "\nPhase: " << name << std::endl;
+        auto start = std::chrono::high_resolution_clock::now();
+        action();
+        auto end = std::chrono::high_resolution_clock::now();
+        phases.emplace_back(name, std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    };
+    
+    timePhase("Create UNLOGGED staging table", [&] {
+        dbManager.createStagingTable(appendExisting);
+    });
+    
+    long long generationMs = 0;
+    timePhase("Load rows into staging (no indexes, no WAL)", [&] {
+        RandomDataGenerator randomGen;
+        for (int loaded = 0; loaded < rowCount; loaded += generationChunk) {
+            auto generationStart = std::chrono::high_resolution_clock::now();
+            auto employees = randomGen.generateEmployees(std::min(generationChunk, rowCount - loaded));
+            generationMs += std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - generationStart).count();
+            dbManager.batchInsertEmployees(employees, DatabaseManager::STAGING_TABLE);
+        }
+        TargetedDataGenerator targetedGen("Male", 'F');
+        dbManager.batchInsertEmployees(targetedGen.generateEmployees(100), DatabaseManager::STAGING_TABLE);
+    });
+    
+    // SET LOGGED rewrites the table and every index on it, so it runs while
+    // there are none; the tuned index build then happens exactly once
+    timePhase("Switch staging to LOGGED", [&] {
+        dbManager.setStagingLogged();
+    });
+    
+    timePhase("Build indexes (parallel maintenance workers)", [&] {
+        dbManager.buildStagingIndexes();
+    });
+    
+    timePhase("VACUUM ANALYZE staging", [&] {
+        dbManager.analyzeStagingTable();
+    });
+    
+    timePhase("Swap staging into employees", [&] {
+        dbManager.swapStagingTable();
+    });
+    
+    long long total = 0;
+    for (const auto& phase : phases) {
+        total += phase.second;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "*** BULK LOAD PHASES ***" << std::endl;
+    for (const auto& phase : phases) {
+        double share = total > 0 ? phase.second * 100.0 / total : 0.0;
+        std::cout << std::left << std::setw(50) << phase.first << std::right
+                  << std::setw(10) << phase.second << " ms" << std::fixed << std::setprecision(1)
+                  << std::setw(8) << share << "%" << std::endl;
+    }
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << std::left << std::setw(50) << "Total" << std::right << std::setw(10) << total << " ms" << std::endl;
+    std::cout << "  (of which client-side data generation: " << generationMs << " ms)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    
+    if (appendExisting) {
+        std::cout << "Baseline skipped: it refills employees in place, run with 'replace' to compare" << std::endl;
+        return;
+    }
+    long long baselineTotal = baselineLoadMs + baselineIndexMs;
+    std::cout << "*** CURRENT PATH (MODE 4 + MODE 6) ***" << std::endl;
+    std::cout << std::left << std::setw(50) << "Insert into employees (live indexes, WAL)" << std::right
+              << std::setw(10) << baselineLoadMs << " ms" << std::endl;
+    std::cout << std::left << std::setw(50) << "Rebuild optimization indexes + VACUUM ANALYZE" << std::right
+              << std::setw(10) << baselineIndexMs << " ms" << std::endl;
+    std::cout << std::left << std::setw(50) << "Total" << std::right << std::setw(10) << baselineTotal << " ms" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << "Bulk load speedup: " << std::fixed << std::setprecision(2)
+              << (total > 0 ? static_cast<double>(baselineTotal) / total : 0.0) << "x ("
+              << baselineTotal - total << " ms saved)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+ResumableFillCommand::ResumableFillCommand(const std::string& loadId, long long totalRows,
+                                           const std::vector<int>& chunkSizes, long long seed)
+    : loadId(loadId), totalRows(totalRows), chunkSizes(chunkSizes), seed(seed) {}
+
+ResumableFillCommand::LoadRun ResumableFillCommand::runLoad(DatabaseManager& dbManager, const std::string& runId,
+                                                            int chunkRows) {
+    // Same shape as mode 4: random rows followed by 100 targeted ones, which
+    // take the last row indices of the load
+    const long long targetedRows = 100;
+    const int maxAttempts = 8;
+    
+    LoadCheckpoint checkpoint = dbManager.beginCheckpointedLoad(runId, seed, totalRows + targetedRows, chunkRows);
+    if (checkpoint.seed != seed || checkpoint.totalRows != totalRows + targetedRows || checkpoint.chunkRows != chunkRows) {
+        std::cout << "Resuming with the stored parameters of load '" << runId << "'" << std::endl;
+    }
+    const long long randomRows = checkpoint.totalRows - targetedRows;
+    
+    std::cout << "Load '" << runId << "': " << checkpoint.rowsCommitted << " / " << checkpoint.totalRows
+              << " rows committed, chunk size " << checkpoint.chunkRows << ", seed " << checkpoint.seed << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    RandomDataGenerator randomGen;
+    TargetedDataGenerator targetedGen("Male", 'F');
+    
+    const long long startRows = checkpoint.rowsCommitted;
+    int reconnects = 0;
+    int failures = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    while (checkpoint.rowsCommitted < checkpoint.totalRows) {
+        long long first = checkpoint.rowsCommitted;
+        long long last = std::min(first + checkpoint.chunkRows, checkpoint.totalRows);
+        
+        std::vector<Employee> chunk;
+        if (first < randomRows) {
+            chunk = randomGen.generateRange(checkpoint.seed, first, static_cast<int>(std::min(last, randomRows) - first));
+        }
+        if (last > randomRows) {
+            long long targetedFirst = std::max(first, randomRows);
+            auto targeted = targetedGen.generateRange(checkpoint.seed, targetedFirst, static_cast<int>(last - targetedFirst));
+            chunk.insert(chunk.end(), targeted.begin(), targeted.end());
+        }
+        
+        try {
+            auto chunkStart = std::chrono::high_resolution_clock::now();
+            dbManager.commitCheckpointedChunk(checkpoint, chunk);
+            auto chunkEnd = std::chrono::high_resolution_clock::now();
+            
+            checkpoint.rowsCommitted = last;
+            failures = 0;
+            
+            auto chunkMs = std::chrono::duration_cast<std::chrono::milliseconds>(chunkEnd - chunkStart).count();
+            std::cout << "Committed rows " << first << ".." << last - 1 << " in " << chunkMs << " ms ("
+                      << std::fixed << std::setprecision(1) << last * 100.0 / checkpoint.totalRows << "%)" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Chunk at row " << first << " failed: " << e.what() << std::endl;
+            
+            // No chunk is attempted until a new session is up and the checkpoint re-read
+            bool recovered = false;
+            while (!recovered) {
+                if (++failures > maxAttempts) {
+                    std::cerr << "Giving up after " << maxAttempts << " attempts; rerun mode 14 with load id '"
+                              << runId << "' to resume" << std::endl;
+                    throw std::runtime_error("Load '" + runId + "' interrupted at row " +
+                                             std::to_string(checkpoint.rowsCommitted));
+                }
+                
+                auto backoff = std::chrono::milliseconds(std::min(500LL << (failures - 1), 30000LL));
+                std::cerr << "Reconnecting in " << backoff.count() << " ms (attempt " << failures << "/"
+                          << maxAttempts << ")..." << std::endl;
+                std::this_thread::sleep_for(backoff);
+                
+                try {
+                    dbManager.reconnect();
+                    ++reconnects;
+                    // The failed commit may still have landed; trust only the stored checkpoint
+                    checkpoint = dbManager.readCheckpoint(runId);
+                    recovered = true;
+                } catch (const std::exception& reconnectError) {
+                    std::cerr << "Reconnect failed: " << reconnectError.what() << std::endl;
+                }
+            }
+        }
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    return {runId, checkpoint.chunkRows, checkpoint.rowsCommitted - startRows,
+            std::chrono::duration<double>(end - start).count(), reconnects};
+}
+
+void ResumableFillCommand::execute(DatabaseManager& dbManager) {
+    std::vector<LoadRun> runs;
+    for (int chunkRows : chunkSizes) {
+        std::string runId = chunkSizes.size() > 1 ? loadId + "-c" + std::to_string(chunkRows) : loadId;
+        runs.push_back(runLoad(dbManager, runId, chunkRows));
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "*** RESUMABLE LOAD RESULTS ***" << std::endl;
+    std::cout << std::left << std::setw(28) << "Load id" << std::right << std::setw(12) << "chunk rows"
+              << std::setw(14) << "rows loaded" << std::setw(12) << "seconds" << std::setw(12) << "reconnects"
+              << std::setw(14) << "rows/s" << std::endl;
+    for (const auto& run : runs) {
+        std::cout << std::left << std::setw(28) << run.loadId << std::right << std::setw(12) << run.chunkRows
+                  << std::setw(14) << run.rowsLoaded << std::fixed << std::setprecision(2)
+                  << std::setw(12) << run.seconds << std::setw(12) << run.reconnects << std::setprecision(0)
+                  << std::setw(14) << (run.seconds > 0 ? run.rowsLoaded / run.seconds : 0.0) << std::endl;
+    }
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+EndpointStatsCommand::EndpointStatsCommand(int reads) : reads(reads > 0 ? reads : 0) {}
+
+void EndpointStatsCommand::execute(DatabaseManager& dbManager) {
+    ReplicaRouter* router = dbManager.getReadRouter();
+    if (!router) {
+        std::cout << "Read routing is disabled: Config::DB_REPLICAS is empty, all queries use the primary." << std::endl;
+        return;
+    }
+    
+    std::cout << "Running health checks..." << std::endl;
+    router->healthCheck();
+    
+    std::cout << "Routing " << reads << " criteria queries (Male, 'F')..." << std::endl;
+    for (int i = 0; i < reads; ++i) {
+        dbManager.getEmployeeViewsByCriteria("Male", "F");
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "*** ENDPOINTS ***" << std::endl;
+    std::cout << std::left << std::setw(24) << "Endpoint" << std::setw(9) << "Role"
+              << std::setw(9) << "Healthy" << std::setw(10) << "Recovery" << std::right
+              << std::setw(7) << "Reads" << std::setw(7) << "Fails"
+              << std::setw(10) << "Check ms" << std::setw(10) << "Min ms" << std::setw(10) << "Avg ms"
+              << std::setw(10) << "Max ms" << std::setw(10) << "EWMA ms" << std::endl;
+    for (const auto& stats : router->stats()) {
+        std::cout << std::left << std::setw(24) << stats.name << std::setw(9) << stats.role
+                  << std::setw(9) << (stats.healthy ? "yes" : "no")
+                  << std::setw(10) << (stats.inRecovery ? "yes" : "no") << std::right
+                  << std::setw(7) << stats.reads << std::setw(7) << stats.failures
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(10) << stats.lastCheckMs
+                  << std::setw(10) << stats.minMs
+                  << std::setw(10) << (stats.reads > 0 ? stats.totalMs / stats.reads : 0.0)
+                  << std::setw(10) << stats.maxMs
+                  << std::setw(10) << stats.ewmaMs << std::endl;
+    }
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+ShardedCommand::ShardedCommand(const std::string& action, const std::vector<std::string>& args)
+    : action(action), args(args) {}
+
+void ShardedCommand::execute(DatabaseManager& dbManager) {
+    ShardedDatabase* shards = dbManager.getShards();
+    if (!shards) {
+        throw std::runtime_error("No shards configured: set Config::DB_SHARDS in include/config.h");
+    }
+    shards->connectAll();
+    std::cout << "Sharded '" << action << "' over " << shards->size() << " shards" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<ShardedDatabase::ShardTiming> timings;
+    
+    if (action == "create") {
+        timings = shards->createTable();
+        
+    } else if (action == "insert") {
+        std::string shard = shards->insertEmployee(args[0], args[1], args[2]);
+        std::cout << "Employee added to shard " << shard << std::endl;
+        
+    } else if (action == "fill") {
+        const int rowCount = args.empty() ? 1000000 : std::stoi(args[0]);
+        const int generationChunk = 100000;
+        
+        std::vector<ShardedDatabase::ShardTiming> totals;
+        auto accumulate = [&totals](const std::vector<ShardedDatabase::ShardTiming>& step) {
+            if (totals.empty()) {
+                totals = step;
+                return;
+            }
+            for (std::size_t i = 0; i < step.size(); ++i) {
+                totals[i].rows += step[i].rows;
+                totals[i].ms += step[i].ms;
+            }
+        };
+        
+        RandomDataGenerator randomGen;
+        for (int loaded = 0; loaded < rowCount; loaded += generationChunk) {
+            accumulate(shards->batchInsertEmployees(randomGen.generateEmployees(std::min(generationChunk, rowCount - loaded))));
+        }
+        TargetedDataGenerator targetedGen("Male", 'F');
+        accumulate(shards->batchInsertEmployees(targetedGen.generateEmployees(100)));
+        timings = totals;
+        
+    } else {
+        bool listing = action == "list";
+        auto merged = listing ? shards->getAllEmployees()
+                              : shards->getEmployeesByCriteria(args.size() > 0 ? args[0] : "Male",
+                                                               args.size() > 1 ? args[1] : "F");
+        
+        std::cout << "Found " << merged.rows.size() << " employees" << std::endl;
+        std::cout << std::string(100, '-') << std::endl;
+        char dateBuffer[EmployeeView::DATE_BUFFER_SIZE];
+        for (const auto& emp : merged.rows) {
+            std::cout << "Full Name: " << emp.fullName << std::endl;
+            std::cout << "Birth Date: " << emp.birthDate(dateBuffer) << std::endl;
+            std::cout << "Gender: " << emp.gender << std::endl;
+            std::cout << "Age: " << emp.age << " years" << std::endl;
+            std::cout << std::string(100, '-') << std::endl;
+        }
+        
+        timings = merged.shards;
+        std::cout << "Client-side k-way merge: " << std::fixed << std::setprecision(2)
+                  << merged.mergeMs << " ms" << std::endl;
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    std::cout << std::string(100, '=') << std::endl;
+    if (!timings.empty()) {
+        std::cout << "*** PER-SHARD TIMINGS ***" << std::endl;
+        printShardTimings(timings);
+        std::cout << std::string(100, '-') << std::endl;
+    }
+    std::cout << "Total (parallel, merged): " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+NameSearchCommand::NameSearchCommand(DatabaseManager::NameMatch match, const std::string& term,
+                                     int limit, double threshold)
+    : match(match), term(term), limit(limit), threshold(threshold) {}
+
+void NameSearchCommand::execute(DatabaseManager& dbManager) {
+    bool fuzzy = match == DatabaseManager::NameMatch::FUZZY;
+    std::cout << (fuzzy ? "Fuzzy" : "Substring") << " search for '" << term << "'";
+    if (fuzzy) {
+        std::cout << " (word similarity >= " << threshold << ")";
+    }
+    std::cout << ", top " << limit << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    auto matches = dbManager.searchEmployeesByName(term, match, limit, threshold);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    for (const auto& emp : matches) {
+        std::cout << "Full Name: " << std::get<0>(emp) << std::endl;
+        std::cout << "Birth Date: " << std::get<1>(emp) << std::endl;
+        std::cout << "Gender: " << std::get<2>(emp) << std::endl;
+        std::cout << "Age: " << std::get<3>(emp) << " years" << std::endl;
+        std::cout << "Score: " << std::fixed << std::setprecision(3) << std::get<4>(emp) << std::endl;
+        std::cout << std::string(100, '-') << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Query completed in " << duration.count() << " ms" << std::endl;
+    std::cout << "Found " << matches.size() << " employees" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+NameSearchBenchmarkCommand::NameSearchBenchmarkCommand(const std::string& substringTerm,
+                                                       const std::string& fuzzyTerm)
+    : substringTerm(substringTerm), fuzzyTerm(fuzzyTerm) {}
+
+void NameSearchBenchmarkCommand::execute(DatabaseManager& dbManager) {
+    const std::vector<long long> sizes = {10000, 100000, 1000000};
+    const std::string benchTable = "name_search_bench";
+    const int runs = 3;
+    const int limit = 50;
+    
+    long long available = 0;
+    {
+        pqxx::work txn(*dbManager.getConnection());
+        available = txn.exec1("SELECT COUNT(*) FROM employees")[0].as<long long>();
+        txn.commit();
+    }
+    std::cout << "Benchmarking name search on samples of employees (" << available << " rows available)" << std::endl;
+    std::cout << "Substring term: '" << substringTerm << "', fuzzy term: '" << fuzzyTerm << "', "
+              << "median of " << runs << " runs, limit " << limit << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    // Median wall time in ms; the matched row count is returned through hits
+    auto measure = [&](DatabaseManager::NameMatch match, const std::string& term, std::size_t& hits) {
+        std::vector<double> times;
+        for (int run = 0; run < runs; ++run) {
+            auto start = std::chrono::high_resolution_clock::now();
+            hits = dbManager.searchEmployeesByName(term, match, limit, DatabaseManager::DEFAULT_FUZZY_THRESHOLD,
+                                                   benchTable).size();
+            auto end = std::chrono::high_resolution_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    };
+    
+    std::cout << std::right << std::setw(10) << "rows" << std::setw(10) << "search"
+              << std::setw(14) << "seq scan ms" << std::setw(14) << "trigram ms"
+              << std::setw(10) << "speedup" << std::setw(8) << "hits" << std::endl;
+    
+    for (long long size : sizes) {
+        if (size > available) {
+            std::cout << std::setw(10) << size << "  skipped: fill employees with at least "
+                      << size << " rows (mode 4)" << std::endl;
+            continue;
+        }
+        {
+            pqxx::nontransaction txn(*dbManager.getConnection());
+            txn.exec("DROP TABLE IF EXISTS " + benchTable);
+            txn.exec("CREATE TEMP TABLE " + benchTable + " AS SELECT * FROM employees LIMIT " + std::to_string(size));
+            // Autovacuum never analyzes temporary tables
+            txn.exec("ANALYZE " + benchTable);
+        }
+        
+        std::size_t substringHits = 0, fuzzyHits = 0;
+        double substringSeq = measure(DatabaseManager::NameMatch::SUBSTRING, substringTerm, substringHits);
+        double fuzzySeq = measure(DatabaseManager::NameMatch::FUZZY, fuzzyTerm, fuzzyHits);
+        
+        dbManager.createTrigramIndex(benchTable);
+        {
+            pqxx::nontransaction txn(*dbManager.getConnection());
+            txn.exec("ANALYZE " + benchTable);
+        }
+        
+        double substringIndexed = measure(DatabaseManager::NameMatch::SUBSTRING, substringTerm, substringHits);
+        double fuzzyIndexed = measure(DatabaseManager::NameMatch::FUZZY, fuzzyTerm, fuzzyHits);
+        
+        auto printRow = [&](const char* label, double seqMs, double indexedMs, std::size_t hits) {
+            std::cout << std::setw(10) << size << std::setw(10) << label << std::fixed << std::setprecision(2)
+                      << std::setw(14) << seqMs << std::setw(14) << indexedMs
+                      << std::setw(9) << (indexedMs > 0 ? seqMs / indexedMs : 0.0) << "x"
+                      << std::setw(8) << hits << std::endl;
+        };
+        printRow("substring", substringSeq, substringIndexed, substringHits);
+        printRow("fuzzy", fuzzySeq, fuzzyIndexed, fuzzyHits);
+    }
+    
+    {
+        pqxx::nontransaction txn(*dbManager.getConnection());
+        txn.exec("DROP TABLE IF EXISTS " + benchTable);
+    }
+    std::cout << std::string(100, '=') << std::endl;
 }
 
+ApproximateQueryCommand::ApproximateQueryCommand(const std::string& gender, const std::string& lastNameStartsWith,
+                                                 double percent, int seed)
+    : gender(gender), lastNameStartsWith(lastNameStartsWith), percent(percent), seed(seed) {}
+
+void ApproximateQueryCommand::execute(DatabaseManager& dbManager) {
+    const double z95 = 1.96;
+    
+    std::cout << "Approximate count: gender = '" << gender << "', surname starts with '" << lastNameStartsWith << "'"
+              << std::endl;
+    std::cout << "Sampling " << percent << "% of the table, seed " << seed << std::endl;
+    std::cout << "Table rows (reltuples): " << std::fixed << std::setprecision(0)
+              << dbManager.estimatedTableRows() << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    auto timed = [](auto&& query, double& ms) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto result = query();
+        auto end = std::chrono::high_resolution_clock::now();
+        ms = std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+    };
+    
+    double exactMs = 0.0;
+    auto employees = timed([&] { return dbManager.getEmployeesByCriteria(gender, lastNameStartsWith); }, exactMs);
+    std::map<int, double> exactBands;
+    for (const auto& emp : employees) {
+        exactBands[std::get<3>(emp) / 10] += 1.0;
+    }
+    const double exact = static_cast<double>(employees.size());
+    
+    struct Estimate {
+        std::string label;
+        ApproximateCount count;
+        double ms;
+        bool hasBounds;
+    };
+    std::vector<Estimate> estimates;
+    for (const char* method : {"SYSTEM", "BERNOULLI"}) {
+        double ms = 0.0;
+        auto count = timed([&] {
+            return dbManager.sampleEmployeesByCriteria(gender, lastNameStartsWith, method, percent, seed);
+        }, ms);
+        estimates.push_back({method, count, ms, true});
+    }
+    {
+        double ms = 0.0;
+        auto count = timed([&] { return dbManager.estimateEmployeesByCriteria(gender, lastNameStartsWith); }, ms);
+        estimates.push_back({"planner", count, ms, false});
+    }
+    
+    std::cout << "*** ESTIMATES ***" << std::endl;
+    std::cout << std::left << std::setw(12) << "source" << std::right << std::setw(12) << "rows"
+              << std::setw(26) << "95% interval" << std::setw(12) << "error" << std::setw(12) << "rows read"
+              << std::setw(12) << "ms" << std::endl;
+    std::cout << std::left << std::setw(12) << "exact" << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << exact << std::setw(26) << "-" << std::setw(12) << "-"
+              << std::setw(12) << "all" << std::setprecision(2) << std::setw(12) << exactMs << std::endl;
+    for (const auto& est : estimates) {
+        std::ostringstream interval;
+        if (est.hasBounds) {
+            interval << std::fixed << std::setprecision(0)
+                     << "[" << std::max(0.0, est.count.estimate - z95 * est.count.stdError)
+                     << ", " << est.count.estimate + z95 * est.count.stdError << "]";
+        } else {
+            interval << "n/a";
+        }
+        std::ostringstream error;
+        if (exact > 0) {
+            error << std::fixed << std::setprecision(1) << (est.count.estimate - exact) * 100.0 / exact << "%";
+        } else {
+            error << "-";
+        }
+        std::cout << std::left << std::setw(12) << est.label << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(12) << est.count.estimate << std::setw(26) << interval.str()
+                  << std::setw(12) << error.str() << std::setw(12)
+                  << (est.hasBounds ? std::to_string(est.count.rowsRead) : std::string("stats"))
+                  << std::setprecision(2) << std::setw(12) << est.ms << std::endl;
+    }
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::set<int> bands;
+    for (const auto& [band, rows] : exactBands) {
+        bands.insert(band);
+    }
+    for (const auto& est : estimates) {
+        for (const auto& [band, rows] : est.count.ageBands) {
+            bands.insert(band);
+        }
+    }
+    
+    std::cout << "*** AGE BANDS (rows, +/- 95% margin) ***" << std::endl;
+    std::cout << std::left << std::setw(12) << "age" << std::right << std::setw(12) << "exact";
+    for (const auto& est : estimates) {
+        std::cout << std::setw(22) << est.label;
+    }
+    std::cout << std::endl;
+    for (int band : bands) {
+        std::ostringstream label;
+        label << band * 10 << "-" << band * 10 + 9;
+        std::cout << std::left << std::setw(12) << label.str() << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(12) << (exactBands.count(band) ? exactBands[band] : 0.0);
+        for (const auto& est : estimates) {
+            auto it = est.count.ageBands.find(band);
+            double rows = it != est.count.ageBands.end() ? it->second : 0.0;
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(0) << rows;
+            if (est.hasBounds) {
+                auto errIt = est.count.ageBandErrors.find(band);
+                cell << " +/- " << (errIt != est.count.ageBandErrors.end() ? z95 * errIt->second : 0.0);
+            }
+            std::cout << std::setw(22) << cell.str();
+        }
+        std::cout << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "SYSTEM intervals use per-block variance; planner estimates carry no error bound." << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+AggregateReportCommand::AggregateReportCommand(int parallelWorkers) : parallelWorkers(parallelWorkers) {}
+
+void AggregateReportCommand::execute(DatabaseManager& dbManager) {
+    std::cout << "Building aggregate report on the server (max_parallel_workers_per_gather = "
+              << parallelWorkers << ")..." << std::endl;
+    auto start1 = std::chrono::high_resolution_clock::now();
+    AggregateReport server = dbManager.buildAggregateReport(parallelWorkers);
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto duration1 = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1);
+    
+    std::cout << "Computing the same report on the client from every row..." << std::endl;
+    auto start2 = std::chrono::high_resolution_clock::now();
+    AggregateReport client = dbManager.buildAggregateReportClientSide();
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto duration2 = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2);
+    std::cout << std::string(100, '=') << std::endl;
+    
+    std::cout << "*** EMPLOYEES BY GENDER AND SURNAME INITIAL ***" << std::endl;
+    std::string currentGender;
+    for (const auto& [key, count] : server.byGenderInitial) {
+        if (key.first != currentGender) {
+            currentGender = key.first;
+            std::cout << (currentGender.empty() ? "(empty)" : currentGender) << ":" << std::endl;
+        }
+        std::cout << "  " << key.second << ": " << count << std::endl;
+    }
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::cout << "*** AGE BANDS ***" << std::endl;
+    for (const auto& [band, count] : server.ageBands) {
+        std::cout << "  " << std::setw(3) << band * 10 << "-" << std::left << std::setw(3) << band * 10 + 9
+                  << std::right << std::setw(10) << count << std::endl;
+    }
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::cout << "Total rows: " << server.totalRows << std::endl;
+    std::cout << "Duplicate (full_name, birth_date) pairs: " << server.duplicateGroups
+              << " (" << server.duplicateRows << " extra rows)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    
+    bool same = server.byGenderInitial == client.byGenderInitial && server.ageBands == client.ageBands &&
+                server.totalRows == client.totalRows && server.duplicateGroups == client.duplicateGroups &&
+                server.duplicateRows == client.duplicateRows;
+    
+    std::cout << "\n*** SERVER VS CLIENT ***" << std::endl;
+    std::cout << std::left << std::setw(24) << "" << std::right << std::setw(12) << "time ms"
+              << std::setw(16) << "rows sent" << std::setw(16) << "bytes sent" << std::endl;
+    std::cout << std::left << std::setw(24) << "Server-side aggregates" << std::right
+              << std::setw(12) << duration1.count() << std::setw(16) << server.rowsTransferred
+              << std::setw(16) << server.wireBytes << std::endl;
+    std::cout << std::left << std::setw(24) << "Client-side from rows" << std::right
+              << std::setw(12) << duration2.count() << std::setw(16) << client.rowsTransferred
+              << std::setw(16) << client.wireBytes << std::endl;
+    std::cout << "Parallel workers planned: " << server.workersPlanned << std::endl;
+    std::cout << "Results match: " << (same ? "yes" : "NO") << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+ScaleLadderCommand::ScaleLadderCommand(const std::vector<long long>& sizes, double targetedRatio,
+                                       const std::string& outputPrefix)
+    : sizes(sizes), targetedRatio(targetedRatio), outputPrefix(outputPrefix) {}
+
+void ScaleLadderCommand::execute(DatabaseManager& dbManager) {
+    const int generationChunk = 100000;
+    const int fetchRows = 50000;
+    
+    // One line of the report: a dataset size measured without or with the mode 6 indexes
+    struct Measurement {
+        long long rows;
+        long long targetedRows;
+        bool optimized;
+        double generateMs;
+        double loadMs;
+        double indexBuildMs;
+        double listingMs;
+        long long listingRows;
+        double queryMs;
+        long long queryRows;
+        RelationSizes sizes;
+    };
+    std::vector<Measurement> report;
+    
+    auto elapsedMs = [](std::chrono::high_resolution_clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - since).count();
+    };
+    
+    std::cout << "Scale ladder: " << sizes.size() << " steps up to " << sizes.back() << " rows, "
+              << std::fixed << std::setprecision(4) << targetedRatio * 100.0 << "% targeted rows" << std::endl;
+    std::cout << "WARNING: the employees table is truncated first" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    
+    dbManager.createTable();
+    dbManager.dropIndex();
+    dbManager.truncateEmployees();
+    // Keeps the binary session setup out of the first step's timings
+    dbManager.prepareViewStatements();
+    
+    RandomDataGenerator randomGen;
+    TargetedDataGenerator targetedGen("Male", 'F');
+    long long loadedRows = 0;
+    long long loadedTargeted = 0;
+    
+    for (long long size : sizes) {
+        // Only the rows missing up to this size are generated and loaded
+        long long delta = size - loadedRows;
+        long long targetedTotal = std::llround(static_cast<double>(size) * targetedRatio);
+        long long targetedDelta = std::min(delta, std::max(0LL, targetedTotal - loadedTargeted));
+        long long randomDelta = delta - targetedDelta;
+        
+        std::cout << "Step " << size << " rows: loading " << randomDelta << " random + "
+                  << targetedDelta << " targeted rows..." << std::endl;
+        
+        double generateMs = 0.0;
+        double loadMs = 0.0;
+        auto load = [&](IDataGenerator& generator, long long count) {
+            for (long long done = 0; done < count; done += generationChunk) {
+                auto genStart = std::chrono::high_resolution_clock::now();
+                auto employees = generator.generateEmployees(static_cast<int>(std::min<long long>(generationChunk, count - done)));
+                generateMs += elapsedMs(genStart);
+                
+                auto loadStart = std::chrono::high_resolution_clock::now();
+                dbManager.insertEmployeesSilently(employees);
+                loadMs += elapsedMs(loadStart);
+            }
+        };
+        load(randomGen, randomDelta);
+        load(targetedGen, targetedDelta);
+        std::cout << "  Batch insert completed: " << delta << " employees added (generation "
+                  << std::setprecision(0) << generateMs << " ms, load " << loadMs << " ms)" << std::endl;
+        loadedRows = size;
+        loadedTargeted += targetedDelta;
+        
+        {
+            pqxx::nontransaction txn(*dbManager.getConnection());
+            txn.exec("ANALYZE employees");
+        }
+        
+        for (bool optimized : {false, true}) {
+            Measurement m{size, loadedTargeted, optimized, generateMs, loadMs, 0.0, 0.0, 0, 0.0, 0, {}};
+            
+            if (optimized) {
+                auto indexStart = std::chrono::high_resolution_clock::now();
+                dbManager.createOptimizationIndex();
+                m.indexBuildMs = elapsedMs(indexStart);
+            }
+            
+            // Mode 3: the full listing, streamed through a cursor and decoded as views
+            long long checksum = 0;
+            auto listingStart = std::chrono::high_resolution_clock::now();
+            m.listingRows = dbManager.streamAllEmployeeViews(fetchRows, [&checksum](const EmployeeResultSet& batch) {
+                for (const auto& emp : batch) {
+                    checksum += emp.age + static_cast<long long>(emp.fullName.size());
+                }
+            });
+            m.listingMs = elapsedMs(listingStart);
+            
+            // Modes 5/6: the selective criteria query, on the primary like every
+            // other column of the row even when read routing is enabled
+            auto queryStart = std::chrono::high_resolution_clock::now();
+            m.queryRows = static_cast<long long>(dbManager.readEmployeeViewsByCriteria("Male", "F").size());
+            m.queryMs = elapsedMs(queryStart);
+            
+            m.sizes = dbManager.getEmployeeTableSizes();
+            report.push_back(m);
+            
+            std::cout << "  " << (optimized ? "optimized" : "no indexes") << ": listing " << std::setprecision(0)
+                      << m.listingMs << " ms (" << m.listingRows << " rows, checksum " << checksum << "), query "
+                      << std::setprecision(2) << m.queryMs << " ms (" << m.queryRows << " rows), table "
+                      << m.sizes.tableBytes / (1024 * 1024) << " MB, indexes "
+                      << m.sizes.indexBytes / (1024 * 1024) << " MB" << std::endl;
+        }
+        
+        // Next step starts from the unoptimized state again
+        dbManager.dropIndex();
+        dbManager.applySessionSetting("RESET work_mem");
+        std::cout << std::string(100, '-') << std::endl;
+    }
+    
+    const std::string csvPath = outputPrefix + ".csv";
+    const std::string jsonPath = outputPrefix + ".json";
+    std::ofstream csv(csvPath);
+    std::ofstream json(jsonPath);
+    if (!csv || !json) {
+        throw std::runtime_error("Cannot write report files " + csvPath + " / " + jsonPath);
+    }
+    
+    csv << "rows,targeted_rows,indexes,generate_ms,load_ms,load_rows_per_s,index_build_ms,"
+        << "listing_ms,listing_rows,query_ms,query_rows,table_bytes,index_bytes\n";
+    json << "[\n";
+    long long previousRows = 0;
+    for (std::size_t i = 0; i < report.size(); ++i) {
+        const Measurement& m = report[i];
+        long long stepRows = m.rows - previousRows;
+        double rowsPerSecond = m.loadMs > 0 ? stepRows * 1000.0 / m.loadMs : 0.0;
+        const char* indexes = m.optimized ? "optimized" : "none";
+        
+        csv << std::fixed << std::setprecision(2)
+            << m.rows << ',' << m.targetedRows << ',' << indexes << ',' << m.generateMs << ',' << m.loadMs << ','
+            << rowsPerSecond << ',' << m.indexBuildMs << ',' << m.listingMs << ',' << m.listingRows << ','
+            << m.queryMs << ',' << m.queryRows << ',' << m.sizes.tableBytes << ',' << m.sizes.indexBytes << '\n';
+        
+        json << std::fixed << std::setprecision(2)
+             << "  {\"rows\": " << m.rows << ", \"targeted_rows\": " << m.targetedRows
+             << ", \"indexes\": \"" << indexes << "\", \"generate_ms\": " << m.generateMs
+             << ", \"load_ms\": " << m.loadMs << ", \"load_rows_per_s\": " << rowsPerSecond
+             << ", \"index_build_ms\": " << m.indexBuildMs << ", \"listing_ms\": " << m.listingMs
+             << ", \"listing_rows\": " << m.listingRows << ", \"query_ms\": " << m.queryMs
+             << ", \"query_rows\": " << m.queryRows << ", \"table_bytes\": " << m.sizes.tableBytes
+             << ", \"index_bytes\": " << m.sizes.indexBytes << "}" << (i + 1 < report.size() ? "," : "") << "\n";
+        
+        if (m.optimized) {
+            previousRows = m.rows;
+        }
+    }
+    json << "]\n";
+    
+    std::cout << "\n*** SCALING REPORT ***" << std::endl;
+    std::cout << std::right << std::setw(12) << "rows" << std::setw(12) << "indexes" << std::setw(12) << "load ms"
+              << std::setw(12) << "list ms" << std::setw(12) << "query ms" << std::setw(10) << "hits"
+              << std::setw(12) << "table MB" << std::setw(12) << "index MB" << std::endl;
+    for (const auto& m : report) {
+        std::cout << std::setw(12) << m.rows << std::setw(12) << (m.optimized ? "optimized" : "none")
+                  << std::fixed << std::setprecision(0) << std::setw(12) << m.loadMs << std::setw(12) << m.listingMs
+                  << std::setprecision(2) << std::setw(12) << m.queryMs << std::setw(10) << m.queryRows
+                  << std::setprecision(1) << std::setw(12) << m.sizes.tableBytes / (1024.0 * 1024.0)
+                  << std::setw(12) << m.sizes.indexBytes / (1024.0 * 1024.0) << std::endl;
+    }
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Report written to " << csvPath << " and " << jsonPath << std::endl;
+}
+
+ColumnarExportCommand::ColumnarExportCommand(const std::string& path, const std::string& gender,
+                                             const std::string& lastNameStartsWith)
+    : path(path), gender(gender), lastNameStartsWith(lastNameStartsWith) {}
+
+void ColumnarExportCommand::execute(DatabaseManager& dbManager) {
+    const int fetchRows = 50000;
+    
+    if (gender.empty()) {
+        std::cout << "Exporting all unique employees to " << path << std::endl;
+    } else {
+        std::cout << "Exporting employees: Gender = " << gender << ", Surname starts with '"
+                  << lastNameStartsWith << "' to " << path << std::endl;
+    }
+    std::cout << std::string(100, '-') << std::endl;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    ColumnarWriter writer(path);
+    auto appendBatch = [&writer](const EmployeeResultSet& batch) { writer.append(batch); };
+    if (gender.empty()) {
+        dbManager.streamAllEmployeeViews(fetchRows, appendBatch);
+    } else {
+        dbManager.streamEmployeeViewsByCriteria(gender, lastNameStartsWith, fetchRows, appendBatch);
+    }
+    writer.finish();
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    std::ifstream written(path, std::ios::binary | std::ios::ate);
+    long long bytes = static_cast<long long>(written.tellg());
+    
+    std::cout << "*** EXPORT COMPLETED ***" << std::endl;
+    std::cout << "Rows: " << writer.rowCount() << " in " << writer.rowGroupCount() << " row groups of up to "
+              << ColumnarWriter::DEFAULT_ROW_GROUP_ROWS << std::endl;
+    std::cout << "File size: " << std::fixed << std::setprecision(2) << bytes / (1024.0 * 1024.0) << " MB" << std::endl;
+    std::cout << "Time: " << ms << " ms (" << std::setprecision(0)
+              << (ms > 0 ? writer.rowCount() * 1000.0 / ms : 0.0) << " rows/s)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
+
+ColumnarScanCommand::ColumnarScanCommand(const std::string& path, int printRows) : path(path), printRows(printRows) {}
+
+void ColumnarScanCommand::execute(DatabaseManager& /*dbManager*/) {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    ColumnarReader reader(path);
+    std::map<std::string, long long> byGender;
+    long long ageSum = 0;
+    long long nameBytes = 0;
+    std::int32_t minDays = std::numeric_limits<std::int32_t>::max();
+    std::int32_t maxDays = std::numeric_limits<std::int32_t>::min();
+    
+    // Column-at-a-time scan: the dictionary codes are counted per row group
+    // and only then mapped to gender strings
+    for (std::size_t g = 0; g < reader.rowGroupCount(); ++g) {
+        auto group = reader.rowGroup(g);
+        const std::size_t rows = group.size();
+        
+        long long codeCounts[256] = {};
+        const std::uint8_t* codes = group.genderCodes();
+        for (std::size_t r = 0; r < rows; ++r) {
+            codeCounts[codes[r]]++;
+        }
+        for (int code = 0; code < 256; ++code) {
+            if (codeCounts[code] > 0) {
+                byGender[std::string(group.genderEntry(static_cast<std::uint8_t>(code)))] += codeCounts[code];
+            }
+        }
+        
+        const std::int32_t* days = group.birthDays();
+        const std::uint8_t* ages = group.ages();
+        for (std::size_t r = 0; r < rows; ++r) {
+            minDays = std::min(minDays, days[r]);
+            maxDays = std::max(maxDays, days[r]);
+            ageSum += ages[r];
+        }
+        for (std::size_t r = 0; r < rows; ++r) {
+            nameBytes += static_cast<long long>(group.fullName(r).size());
+        }
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    int printed = 0;
+    char dateBuffer[EmployeeView::DATE_BUFFER_SIZE];
+    for (std::size_t g = 0; g < reader.rowGroupCount() && printed < printRows; ++g) {
+        auto group = reader.rowGroup(g);
+        for (std::size_t r = 0; r < group.size() && printed < printRows; ++r, ++printed) {
+            EmployeeView emp = group[r];
+            std::cout << "Full Name: " << emp.fullName << std::endl;
+            std::cout << "Birth Date: " << emp.birthDate(dateBuffer) << std::endl;
+            std::cout << "Gender: " << emp.gender << std::endl;
+            std::cout << "Age: " << emp.age << " years" << std::endl;
+            std::cout << std::string(100, '-') << std::endl;
+        }
+    }
+    
+    std::cout << "*** SCAN OF " << path << " ***" << std::endl;
+    std::cout << "Rows: " << reader.rowCount() << " in " << reader.rowGroupCount() << " row groups" << std::endl;
+    for (const auto& [genderValue, count] : byGender) {
+        std::cout << "  " << genderValue << ": " << count << std::endl;
+    }
+    if (reader.rowCount() > 0) {
+        EmployeeView oldest{};
+        oldest.birthDays = minDays;
+        EmployeeView youngest{};
+        youngest.birthDays = maxDays;
+        char youngestBuffer[EmployeeView::DATE_BUFFER_SIZE];
+        std::cout << "Birth dates: " << oldest.birthDate(dateBuffer) << " .. " << youngest.birthDate(youngestBuffer)
+                  << std::endl;
+        std::cout << "Average age: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(ageSum) / reader.rowCount() << std::endl;
+        std::cout << "Name bytes: " << nameBytes << std::endl;
+    }
+    std::cout << "Scan time: " << std::fixed << std::setprecision(2) << ms << " ms ("
+              << (ms > 0 ? reader.sizeBytes() / (1024.0 * 1024.0) * 1000.0 / ms : 0.0) << " MB/s, "
+              << std::setprecision(0) << (ms > 0 ? reader.rowCount() * 1000.0 / ms : 0.0) << " rows/s)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
@@ -1,11 +1,38 @@
 #include "DatabaseManager.h"
 #include "Employee.h"
+#include "ReplicaRouter.h"
+#include "ShardedDatabase.h"
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <regex>
+
+namespace {
+    const char* const ALL_EMPLOYEE_VIEWS_SQL = R"(
+            SELECT DISTINCT ON (full_name, birth_date) 
+                full_name, birth_date, gender,
+                EXTRACT(YEAR FROM AGE(birth_date))::int4 as age
+            FROM employees
+            ORDER BY full_name, birth_date
+        )";
+    
+    // Mode 5 query, shared by the prepared text, binary and cursor paths.
+    // $1 is the gender, $2 the LIKE pattern for the name prefix.
+    const char* const EMPLOYEE_VIEWS_BY_CRITERIA_SQL = R"(
+            SELECT full_name, birth_date, gender,
+                   EXTRACT(YEAR FROM AGE(birth_date))::int4 as age
+            FROM employees
+            WHERE gender = $1
+              AND full_name LIKE $2
+            ORDER BY full_name
+        )";
+}
 
 DatabaseManager::DatabaseManager(const std::string& host, const std::string& port,
                                const std::string& dbname, const std::string& user,
-                               const std::string& password) : conn(nullptr) {
+                               const std::string& password) : conn(nullptr), statementsPrepared(false) {
     std::ostringstream oss;
     oss << "host=" << host 
         << " port=" << port 
@@ -15,6 +42,9 @@ DatabaseManager::DatabaseManager(const std::string& host, const std::string& por
     connectionString = oss.str();
 }
 
+DatabaseManager::DatabaseManager(const std::string& connectionString_)
+    : conn(nullptr), connectionString(connectionString_), statementsPrepared(false) {}
+
 DatabaseManager::~DatabaseManager() {
     // Note: libpqxx 7.x may trigger false positive "double free" warnings
     // This is a known issue (see libpqxx #932 in libpqxx github) and can be safely ignored
@@ -28,6 +58,14 @@ DatabaseManager::~DatabaseManager() {
 void DatabaseManager::connect() {
     try {
         conn = new pqxx::connection(connectionString);
+        statementsPrepared = false;
+        binaryConn.reset();
+        if (!sessionSettings.empty()) {
+            pqxx::nontransaction txn(*conn);
+            for (const auto& setting : sessionSettings) {
+                txn.exec(setting);
+            }
+        }
         if (conn->is_open()) {
             std::cout << "Successfully connected to database" << std::endl;
         }
@@ -42,6 +80,38 @@ void DatabaseManager::disconnect() {
         delete conn;
         conn = nullptr;
     }
+    statementsPrepared = false;
+    binaryConn.reset();
+}
+
+const std::string& DatabaseManager::getConnectionString() const {
+    return connectionString;
+}
+
+void DatabaseManager::prepareStatements() {
+    if (statementsPrepared) {
+        return;
+    }
+    
+    conn->prepare("insert_employee",
+        "INSERT INTO employees (full_name, birth_date, gender) VALUES ($1, $2, $3)");
+    conn->prepare("employees_by_criteria", EMPLOYEE_VIEWS_BY_CRITERIA_SQL);
+    
+    // A generic plan cannot prove the partial index predicates from mode 6,
+    // so always plan with the actual parameter values.
+    pqxx::nontransaction txn(*conn);
+    txn.exec("SET plan_cache_mode = force_custom_plan");
+    
+    statementsPrepared = true;
+}
+
+void DatabaseManager::reconnect() {
+    disconnect();
+    connect();
+}
+
+bool DatabaseManager::isConnected() const {
+    return conn != nullptr && conn->is_open();
 }
 
 void DatabaseManager::createTable() {
@@ -70,41 +140,46 @@ void DatabaseManager::insertEmployee(const std::string& fullName,
                                     const std::string& birthDate,
                                     const std::string& gender) {
     try {
+        prepareStatements();
         pqxx::work txn(*conn);
         
-        std::ostringstream query;
-        query << "INSERT INTO employees (full_name, birth_date, gender) VALUES ("
-              << txn.quote(fullName) << ", "
-              << txn.quote(birthDate) << ", "
-              << txn.quote(gender) << ")";
-        
-        txn.exec(query.str());
+        txn.exec_prepared("insert_employee", fullName, birthDate, gender);
         txn.commit();
-        
-        std::cout << "Employee added successfully" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error inserting employee: " << e.what() << std::endl;
         throw;
     }
 }
 
-void DatabaseManager::batchInsertEmployees(const std::vector<Employee>& employees) {
-    try {
-        pqxx::work txn(*conn);
-        
-        std::ostringstream query;
-        query << "INSERT INTO employees (full_name, birth_date, gender) VALUES ";
-        
-        for (size_t i = 0; i < employees.size(); ++i) {
-            if (i > 0) query << ", ";
-            query << "("
-                  << txn.quote(employees[i].getFullName()) << ", "
-                  << txn.quote(employees[i].getBirthDate()) << ", "
-                  << txn.quote(employees[i].getGender()) << ")";
+void DatabaseManager::insertEmployeeRows(pqxx::work& txn, const std::vector<Employee>& employees,
+                                         const std::string& table) {
+    // Statements are flushed chunk by chunk from one reused buffer, so the
+    // serializer never holds more than InsertSerializer::DEFAULT_CHUNK_ROWS rows
+    insertBuffer.setTable(table);
+    for (const auto& employee : employees) {
+        insertBuffer.append(employee);
+        if (insertBuffer.full()) {
+            txn.exec(insertBuffer.statement());
+            insertBuffer.reset();
         }
-        
-        txn.exec(query.str());
-        txn.commit();
+    }
+    if (!insertBuffer.empty()) {
+        txn.exec(insertBuffer.statement());
+        insertBuffer.reset();
+    }
+}
+
+void DatabaseManager::insertEmployeesSilently(const std::vector<Employee>& employees,
+                                              const std::string& table) {
+    pqxx::work txn(*conn);
+    insertEmployeeRows(txn, employees, table);
+    txn.commit();
+}
+
+void DatabaseManager::batchInsertEmployees(const std::vector<Employee>& employees,
+                                           const std::string& table) {
+    try {
+        insertEmployeesSilently(employees, table);
         
         std::cout << "Batch insert completed: " << employees.size() << " employees added" << std::endl;
     } catch (const std::exception& e) {
@@ -113,8 +188,68 @@ void DatabaseManager::batchInsertEmployees(const std::vector<Employee>& employee
     }
 }
 
+LoadCheckpoint DatabaseManager::readCheckpoint(const std::string& loadId) {
+    pqxx::work txn(*conn);
+    pqxx::row row = txn.exec1(
+        "SELECT seed, total_rows, chunk_rows, rows_committed FROM load_checkpoints "
+        "WHERE load_id = " + txn.quote(loadId));
+    txn.commit();
+    
+    LoadCheckpoint checkpoint;
+    checkpoint.loadId = loadId;
+    checkpoint.seed = row[0].as<long long>();
+    checkpoint.totalRows = row[1].as<long long>();
+    checkpoint.chunkRows = row[2].as<int>();
+    checkpoint.rowsCommitted = row[3].as<long long>();
+    return checkpoint;
+}
+
+LoadCheckpoint DatabaseManager::beginCheckpointedLoad(const std::string& loadId, long long seed,
+                                                      long long totalRows, int chunkRows) {
+    try {
+        pqxx::work txn(*conn);
+        txn.exec(R"(
+            CREATE TABLE IF NOT EXISTS load_checkpoints (
+                load_id TEXT PRIMARY KEY,
+                seed BIGINT NOT NULL,
+                total_rows BIGINT NOT NULL,
+                chunk_rows INT NOT NULL,
+                rows_committed BIGINT NOT NULL DEFAULT 0,
+                started_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+            )
+        )");
+        txn.exec("INSERT INTO load_checkpoints (load_id, seed, total_rows, chunk_rows) VALUES (" +
+                 txn.quote(loadId) + ", " + txn.quote(seed) + ", " + txn.quote(totalRows) + ", " +
+                 txn.quote(chunkRows) + ") ON CONFLICT (load_id) DO NOTHING");
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error creating load checkpoint: " << e.what() << std::endl;
+        throw;
+    }
+    return readCheckpoint(loadId);
+}
+
+void DatabaseManager::commitCheckpointedChunk(const LoadCheckpoint& checkpoint,
+                                              const std::vector<Employee>& employees) {
+    pqxx::work txn(*conn);
+    insertEmployeeRows(txn, employees, "employees");
+    
+    // Guarded by the expected progress so two loaders cannot both advance it
+    pqxx::result res = txn.exec(
+        "UPDATE load_checkpoints SET rows_committed = rows_committed + " +
+        std::to_string(employees.size()) + ", updated_at = CURRENT_TIMESTAMP "
+        "WHERE load_id = " + txn.quote(checkpoint.loadId) +
+        " AND rows_committed = " + std::to_string(checkpoint.rowsCommitted));
+    if (res.affected_rows() != 1) {
+        throw std::runtime_error("Checkpoint for load '" + checkpoint.loadId +
+                                 "' moved concurrently; another loader is running");
+    }
+    txn.commit();
+}
+
 std::vector<std::tuple<std::string, std::string, std::string, int>> 
-DatabaseManager::getAllEmployees() {
+DatabaseManager::readAllEmployees() {
     std::vector<std::tuple<std::string, std::string, std::string, int>> result;
     
     try {
@@ -147,24 +282,16 @@ DatabaseManager::getAllEmployees() {
 }
 
 std::vector<std::tuple<std::string, std::string, std::string, int>> 
-DatabaseManager::getEmployeesByCriteria(const std::string& gender, 
+DatabaseManager::readEmployeesByCriteria(const std::string& gender, 
                                         const std::string& lastNameStartsWith) {
     std::vector<std::tuple<std::string, std::string, std::string, int>> result;
     
     try {
+        prepareStatements();
         pqxx::work txn(*conn);
         
-        std::ostringstream query;
-        query << R"(
-            SELECT full_name, birth_date, gender,
-                   EXTRACT(YEAR FROM AGE(birth_date)) as age
-            FROM employees
-            WHERE gender = )" << txn.quote(gender) << R"(
-              AND full_name LIKE )" << txn.quote(lastNameStartsWith + "%") << R"(
-            ORDER BY full_name
-        )";
-        
-        pqxx::result res = txn.exec(query.str());
+        pqxx::result res = txn.exec_prepared("employees_by_criteria",
+                                             gender, lastNameStartsWith + "%");
         
         for (const auto& row : res) {
             std::string fullName = row[0].as<std::string>();
@@ -184,6 +311,337 @@ DatabaseManager::getEmployeesByCriteria(const std::string& gender,
     return result;
 }
 
+EmployeeResultSet DatabaseManager::readAllEmployeeViews() {
+    try {
+        return getBinaryConnection().queryEmployees("all_employees", ALL_EMPLOYEE_VIEWS_SQL, {});
+    } catch (const std::exception& e) {
+        std::cerr << "Error retrieving employees: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+EmployeeResultSet DatabaseManager::readEmployeeViewsByCriteria(const std::string& gender,
+                                                               const std::string& lastNameStartsWith) {
+    try {
+        return getBinaryConnection().queryEmployees("employees_by_criteria", EMPLOYEE_VIEWS_BY_CRITERIA_SQL,
+                                                    {gender, lastNameStartsWith + "%"});
+    } catch (const std::exception& e) {
+        std::cerr << "Error retrieving employees by criteria: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+std::vector<std::tuple<std::string, std::string, std::string, int>> 
+DatabaseManager::getAllEmployees() {
+    if (router && router->hasReplicas()) {
+        return router->route([](DatabaseManager& db) { return db.readAllEmployees(); });
+    }
+    return readAllEmployees();
+}
+
+std::vector<std::tuple<std::string, std::string, std::string, int>> 
+DatabaseManager::getEmployeesByCriteria(const std::string& gender, const std::string& lastNameStartsWith) {
+    if (router && router->hasReplicas()) {
+        return router->route([&](DatabaseManager& db) {
+            return db.readEmployeesByCriteria(gender, lastNameStartsWith);
+        });
+    }
+    return readEmployeesByCriteria(gender, lastNameStartsWith);
+}
+
+EmployeeResultSet DatabaseManager::getAllEmployeeViews() {
+    if (router && router->hasReplicas()) {
+        return router->route([](DatabaseManager& db) { return db.readAllEmployeeViews(); });
+    }
+    return readAllEmployeeViews();
+}
+
+EmployeeResultSet DatabaseManager::getEmployeeViewsByCriteria(const std::string& gender,
+                                                              const std::string& lastNameStartsWith) {
+    if (router && router->hasReplicas()) {
+        return router->route([&](DatabaseManager& db) {
+            return db.readEmployeeViewsByCriteria(gender, lastNameStartsWith);
+        });
+    }
+    return readEmployeeViewsByCriteria(gender, lastNameStartsWith);
+}
+
+void DatabaseManager::enableReadRouting(const std::string& primaryName, const std::string& policy) {
+    router = std::make_unique<ReplicaRouter>(*this, primaryName, ReplicaRouter::parsePolicy(policy));
+}
+
+void DatabaseManager::addReadReplica(const std::string& name, std::unique_ptr<DatabaseManager> replica) {
+    if (!router) {
+        enableReadRouting("primary", "round-robin");
+    }
+    for (const auto& setting : sessionSettings) {
+        replica->applySessionSetting(setting);
+    }
+    router->addReplica(name, std::move(replica));
+}
+
+ReplicaRouter* DatabaseManager::getReadRouter() {
+    return router.get();
+}
+
+void DatabaseManager::setShards(std::unique_ptr<ShardedDatabase> shards) {
+    shardSet = std::move(shards);
+}
+
+ShardedDatabase* DatabaseManager::getShards() {
+    return shardSet.get();
+}
+
+long long DatabaseManager::streamEmployeeViews(const std::string& sql, int fetchRows,
+                                              const std::function<void(const EmployeeResultSet&)>& visit) {
+    BinaryConnection& binary = getBinaryConnection();
+    long long streamed = 0;
+    
+    try {
+        binary.execute("BEGIN");
+        binary.execute("DECLARE employee_stream NO SCROLL CURSOR FOR " + sql);
+        const std::string fetch = "FETCH " + std::to_string(fetchRows) + " FROM employee_stream";
+        while (true) {
+            EmployeeResultSet batch = binary.queryEmployees(fetch);
+            if (batch.empty()) {
+                break;
+            }
+            visit(batch);
+            streamed += static_cast<long long>(batch.size());
+        }
+        binary.execute("CLOSE employee_stream");
+        binary.execute("COMMIT");
+    } catch (const std::exception& e) {
+        try {
+            binary.execute("ROLLBACK");
+        } catch (const std::exception&) { }
+        std::cerr << "Error streaming employees: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return streamed;
+}
+
+long long DatabaseManager::streamAllEmployeeViews(int fetchRows,
+                                                 const std::function<void(const EmployeeResultSet&)>& visit) {
+    return streamEmployeeViews(ALL_EMPLOYEE_VIEWS_SQL, fetchRows, visit);
+}
+
+long long DatabaseManager::streamEmployeeViewsByCriteria(const std::string& gender,
+                                                        const std::string& lastNameStartsWith, int fetchRows,
+                                                        const std::function<void(const EmployeeResultSet&)>& visit) {
+    // DECLARE takes no parameters, so the criteria are quoted into the statement.
+    // $2 is substituted first so a quoted value can never be mistaken for $1.
+    std::string query = EMPLOYEE_VIEWS_BY_CRITERIA_SQL;
+    const std::pair<std::string, std::string> literals[] = {
+        {"$2", conn->quote(lastNameStartsWith + "%")},
+        {"$1", conn->quote(gender)},
+    };
+    for (const auto& literal : literals) {
+        query.replace(query.find(literal.first), literal.first.size(), literal.second);
+    }
+    return streamEmployeeViews(query, fetchRows, visit);
+}
+
+void DatabaseManager::truncateEmployees() {
+    try {
+        pqxx::work txn(*conn);
+        txn.exec("TRUNCATE employees RESTART IDENTITY");
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error truncating employees: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+RelationSizes DatabaseManager::getEmployeeTableSizes() {
+    RelationSizes sizes;
+    
+    try {
+        pqxx::work txn(*conn);
+        pqxx::row row = txn.exec1("SELECT pg_table_size('employees'), pg_indexes_size('employees')");
+        sizes.tableBytes = row[0].as<long long>();
+        sizes.indexBytes = row[1].as<long long>();
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading table sizes: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return sizes;
+}
+
+void DatabaseManager::applySessionSetting(const std::string& sql) {
+    if (conn) {
+        pqxx::nontransaction txn(*conn);
+        txn.exec(sql);
+    }
+    if (binaryConn) {
+        binaryConn->execute(sql);
+    }
+    if (router) {
+        router->applySessionSetting(sql);
+    }
+    // Keep replay order equal to apply order, so a later SET/RESET of the
+    // same parameter still wins after a reconnect
+    sessionSettings.erase(std::remove(sessionSettings.begin(), sessionSettings.end(), sql),
+                          sessionSettings.end());
+    sessionSettings.push_back(sql);
+}
+
+const char* const DatabaseManager::STAGING_TABLE = "employees_staging";
+
+void DatabaseManager::createStagingTable(bool copyExistingRows) {
+    try {
+        pqxx::work txn(*conn);
+        stagedIndexes.clear();
+        txn.exec(std::string("DROP TABLE IF EXISTS ") + STAGING_TABLE);
+        // Defaults only: the primary key and all indexes are deferred to buildStagingIndexes()
+        txn.exec(std::string("CREATE UNLOGGED TABLE ") + STAGING_TABLE +
+                 " (LIKE employees INCLUDING DEFAULTS)");
+        if (copyExistingRows) {
+            pqxx::result res = txn.exec(std::string("INSERT INTO ") + STAGING_TABLE +
+                                        " SELECT * FROM employees");
+            std::cout << "Copied " << res.affected_rows() << " existing rows into staging" << std::endl;
+        }
+        txn.commit();
+        std::cout << "Staging table '" << STAGING_TABLE << "' created (UNLOGGED, no indexes)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error creating staging table: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+void DatabaseManager::buildStagingIndexes() {
+    try {
+        pqxx::nontransaction txn(*conn);
+        txn.exec("SET maintenance_work_mem = '1GB'");
+        txn.exec("SET max_parallel_maintenance_workers = 4");
+        
+        // The raised settings must not outlive this call, even when a build fails
+        auto resetSettings = [&txn]() {
+            txn.exec("RESET maintenance_work_mem");
+            txn.exec("RESET max_parallel_maintenance_workers");
+        };
+        
+        pqxx::result indexes;
+        try {
+            std::cout << "  Building primary key..." << std::endl;
+            txn.exec(std::string("ALTER TABLE ") + STAGING_TABLE + " ADD PRIMARY KEY (id)");
+            
+            // Only the primary key is recreated among constraint indexes; losing
+            // any other constraint in the swap must not go unnoticed
+            pqxx::result constraints = txn.exec(
+                "SELECT conname FROM pg_constraint "
+                "WHERE conrelid = 'employees'::regclass AND conindid <> 0 AND contype <> 'p'");
+            if (!constraints.empty()) {
+                throw std::runtime_error("employees has index-backed constraint " +
+                                         constraints[0][0].as<std::string>() +
+                                         ", which the bulk load cannot recreate");
+            }
+            
+            // Recreate every secondary index that currently exists on employees,
+            // including the ones from createOptimizationIndex(). The definition is
+            // pg_get_indexdef() with its "CREATE INDEX name ON table USING" head
+            // rebuilt from the catalog, so quoted names survive, and each index
+            // gets a short temporary name derived from its OID.
+            indexes = txn.exec(std::string(R"(
+                SELECT c.relname,
+                       d.stagedName,
+                       left(d.definition, length(d.head)) = d.head,
+                       d.definition,
+                       format('CREATE %sINDEX %I ON %I.%I USING %s', d.uniqueness, d.stagedName,
+                              current_schema(), )") + txn.quote(STAGING_TABLE) + R"(,
+                              substr(d.definition, length(d.head) + 1))
+                FROM pg_index x
+                JOIN pg_class c ON c.oid = x.indexrelid
+                JOIN pg_namespace n ON n.oid = c.relnamespace
+                CROSS JOIN LATERAL (
+                    SELECT pg_get_indexdef(x.indexrelid) AS definition,
+                           'employees_bulk_' || x.indexrelid AS stagedName,
+                           CASE WHEN x.indisunique THEN 'UNIQUE ' ELSE '' END AS uniqueness,
+                           format('CREATE %sINDEX %I ON %I.%I USING ',
+                                  CASE WHEN x.indisunique THEN 'UNIQUE ' ELSE '' END,
+                                  c.relname, n.nspname, 'employees') AS head
+                ) d
+                WHERE x.indrelid = 'employees'::regclass
+                  AND NOT EXISTS (SELECT 1 FROM pg_constraint k WHERE k.conindid = x.indexrelid)
+                ORDER BY c.relname
+            )");
+            
+            for (const auto& row : indexes) {
+                std::string name = row[0].as<std::string>();
+                if (!row[2].as<bool>()) {
+                    throw std::runtime_error("Cannot recreate index " + name + " from its definition: " +
+                                             row[3].as<std::string>());
+                }
+                std::cout << "  Building " << name << "..." << std::endl;
+                txn.exec(row[4].as<std::string>());
+                stagedIndexes.emplace_back(row[1].as<std::string>(), name);
+            }
+        } catch (const std::exception&) {
+            try {
+                resetSettings();
+            } catch (const std::exception&) { }
+            throw;
+        }
+        resetSettings();
+        std::cout << "Staging indexes built: primary key + " << indexes.size() << " secondary" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error building staging indexes: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+void DatabaseManager::setStagingLogged() {
+    try {
+        pqxx::nontransaction txn(*conn);
+        txn.exec(std::string("ALTER TABLE ") + STAGING_TABLE + " SET LOGGED");
+        std::cout << "Staging table is now LOGGED (crash-safe)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error switching staging table to LOGGED: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+void DatabaseManager::analyzeStagingTable() {
+    try {
+        pqxx::nontransaction txn(*conn);
+        txn.exec(std::string("VACUUM ANALYZE ") + STAGING_TABLE);
+        std::cout << "VACUUM ANALYZE on staging table completed" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error analyzing staging table: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+void DatabaseManager::swapStagingTable() {
+    try {
+        pqxx::work txn(*conn);
+        
+        // The id sequence is owned by employees.id and would be dropped with it
+        std::string sequence = txn.exec1(
+            "SELECT pg_get_serial_sequence('employees', 'id')")[0].as<std::string>();
+        txn.exec("ALTER SEQUENCE " + sequence + " OWNED BY " + STAGING_TABLE + ".id");
+        
+        txn.exec("DROP TABLE employees");
+        txn.exec(std::string("ALTER TABLE ") + STAGING_TABLE + " RENAME TO employees");
+        txn.exec(std::string("ALTER TABLE employees RENAME CONSTRAINT ") + STAGING_TABLE +
+                 "_pkey TO employees_pkey");
+        
+        for (const auto& index : stagedIndexes) {
+            txn.exec("ALTER INDEX " + txn.quote_name(index.first) + " RENAME TO " + txn.quote_name(index.second));
+        }
+        
+        txn.commit();
+        stagedIndexes.clear();
+        std::cout << "Staging table swapped in as 'employees'" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error swapping staging table: " << e.what() << std::endl;
+        throw;
+    }
+}
+
 void DatabaseManager::createOptimizationIndex() {
     try {
         std::cout << "  Step 1: Creating partial index for Male employees with surname 'F'..." << std::endl;
@@ -210,19 +668,19 @@ void DatabaseManager::createOptimizationIndex() {
         }
         std::cout << "       Covering index created" << std::endl;
         
-        std::cout << "  Step 3: Running VACUUM ANALYZE to optimize table..." << std::endl;
+        std::cout << "  Step 3: Creating trigram index for substring and fuzzy name search..." << std::endl;
+        createTrigramIndex();
+        std::cout << "       Trigram index created" << std::endl;
+        
+        std::cout << "  Step 4: Running VACUUM ANALYZE to optimize table..." << std::endl;
         {
             pqxx::nontransaction ntxn(*conn);
             ntxn.exec("VACUUM ANALYZE employees");
         }
         std::cout << "       VACUUM ANALYZE completed" << std::endl;
         
-        std::cout << "  Step 4: Increasing work_mem for better sort performance..." << std::endl;
-        {
-            pqxx::work txn(*conn);
-            txn.exec("SET work_mem = '256MB'");
-            txn.commit();
-        }
+        std::cout << "  Step 5: Increasing work_mem for better sort performance..." << std::endl;
+        applySessionSetting("SET work_mem = '256MB'");
         std::cout << "       work_mem increased to 256MB" << std::endl;
         
         std::cout << "\nOptimization completed!" << std::endl;
@@ -239,6 +697,7 @@ void DatabaseManager::dropIndex() {
         txn.exec("DROP INDEX IF EXISTS idx_employees_male_f_surname");
         txn.exec("DROP INDEX IF EXISTS idx_employees_covering");
         txn.exec("DROP INDEX IF EXISTS idx_employees_gender_name");
+        txn.exec("DROP INDEX IF EXISTS idx_employees_name_trgm");
         
         std::cout << "All optimization indexes dropped successfully" << std::endl;
     } catch (const std::exception& e) {
@@ -283,6 +742,379 @@ void DatabaseManager::explainQuery(const std::string& gender, const std::string&
     }
 }
 
+ApproximateCount DatabaseManager::sampleEmployeesByCriteria(const std::string& gender,
+                                                           const std::string& lastNameStartsWith,
+                                                           const std::string& method, double percent, int seed) {
+    if (method != "SYSTEM" && method != "BERNOULLI") {
+        throw std::invalid_argument("Unknown TABLESAMPLE method: " + method);
+    }
+    
+    ApproximateCount result;
+    
+    try {
+        pqxx::work txn(*conn);
+        
+        // Matching rows grouped by heap block and age band, plus one (-1, -1)
+        // row carrying the number of sampled rows
+        std::ostringstream query;
+        query << "WITH sampled AS ("
+              << "SELECT (ctid::text::point)[0]::bigint AS block, gender, full_name, "
+              << "EXTRACT(YEAR FROM AGE(birth_date))::int / 10 AS band "
+              << "FROM employees TABLESAMPLE " << method << " (" << percent << ") "
+              << "REPEATABLE (" << seed << ")) "
+              << "SELECT block, band, COUNT(*) FROM sampled "
+              << "WHERE gender = " << txn.quote(gender) << " "
+              << "AND full_name LIKE " << txn.quote(lastNameStartsWith + "%") << " "
+              << "GROUP BY block, band "
+              << "UNION ALL SELECT -1, -1, COUNT(*) FROM sampled";
+        
+        pqxx::result res = txn.exec(query.str());
+        txn.commit();
+        
+        // Each sampling unit (a block for SYSTEM, a row for BERNOULLI) is kept
+        // with probability q, so the estimate is hits / q and its variance
+        // estimate is (1 - q) / q^2 * sum of squared per-unit hits.
+        const double q = percent / 100.0;
+        const bool rowUnits = method == "BERNOULLI";
+        std::map<long long, double> blockHits;
+        std::map<int, std::map<long long, double>> bandBlockHits;
+        double hits = 0.0;
+        
+        for (const auto& row : res) {
+            long long block = row[0].as<long long>();
+            int band = row[1].as<int>();
+            double count = row[2].as<double>();
+            if (block < 0) {
+                result.rowsRead = static_cast<long long>(count);
+                continue;
+            }
+            hits += count;
+            blockHits[block] += count;
+            bandBlockHits[band][block] += count;
+        }
+        
+        auto squaredUnitHits = [rowUnits](const std::map<long long, double>& perBlock) {
+            double sum = 0.0;
+            for (const auto& [block, count] : perBlock) {
+                sum += rowUnits ? count : count * count;
+            }
+            return sum;
+        };
+        const double varianceScale = (1.0 - q) / (q * q);
+        
+        result.estimate = hits / q;
+        result.stdError = std::sqrt(varianceScale * squaredUnitHits(blockHits));
+        for (const auto& [band, perBlock] : bandBlockHits) {
+            double bandHits = 0.0;
+            for (const auto& [block, count] : perBlock) {
+                bandHits += count;
+            }
+            result.ageBands[band] = bandHits / q;
+            result.ageBandErrors[band] = std::sqrt(varianceScale * squaredUnitHits(perBlock));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error sampling employees: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return result;
+}
+
+ApproximateCount DatabaseManager::estimateEmployeesByCriteria(const std::string& gender,
+                                                             const std::string& lastNameStartsWith) {
+    ApproximateCount result;
+    
+    try {
+        pqxx::work txn(*conn);
+        
+        // The top plan node carries the planner's row estimate for the whole query
+        pqxx::result plan = txn.exec("EXPLAIN SELECT 1 FROM employees WHERE gender = " + txn.quote(gender) +
+                                     " AND full_name LIKE " + txn.quote(lastNameStartsWith + "%"));
+        std::smatch match;
+        std::string topNode = plan[0][0].as<std::string>();
+        if (std::regex_search(topNode, match, std::regex(R"(rows=(\d+))"))) {
+            result.estimate = std::stod(match[1].str());
+        }
+        
+        // Equi-depth birth_date histogram: every bucket holds the same share of
+        // rows, so each band gets the share of buckets whose midpoint falls in it
+        pqxx::result bands = txn.exec(R"(
+            WITH bounds AS (
+                SELECT bound, ord
+                FROM pg_stats,
+                     unnest(histogram_bounds::text::date[]) WITH ORDINALITY AS b(bound, ord)
+                WHERE schemaname = current_schema() AND tablename = 'employees' AND attname = 'birth_date'
+            ), buckets AS (
+                SELECT lo.bound + (hi.bound - lo.bound) / 2 AS midpoint
+                FROM bounds lo JOIN bounds hi ON hi.ord = lo.ord + 1
+            )
+            SELECT EXTRACT(YEAR FROM AGE(midpoint))::int / 10 AS band,
+                   COUNT(*)::float8 / SUM(COUNT(*)) OVER () AS share
+            FROM buckets
+            GROUP BY band
+            ORDER BY band
+        )");
+        for (const auto& row : bands) {
+            result.ageBands[row[0].as<int>()] = result.estimate * row[1].as<double>();
+        }
+        
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading planner estimate: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return result;
+}
+
+double DatabaseManager::estimatedTableRows() {
+    try {
+        pqxx::work txn(*conn);
+        double rows = txn.exec1("SELECT reltuples::float8 FROM pg_class WHERE oid = 'employees'::regclass")[0].as<double>();
+        txn.commit();
+        return rows;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading table statistics: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+namespace {
+    // Bytes of the protocol DataRow messages for a result: type, length and
+    // field count per row, then a length word and the value per field
+    long long resultWireBytes(const pqxx::result& res) {
+        long long bytes = 0;
+        for (const auto& row : res) {
+            bytes += 1 + 4 + 2;
+            for (int i = 0; i < static_cast<int>(row.size()); ++i) {
+                bytes += 4 + (row[i].is_null() ? 0 : static_cast<long long>(row[i].size()));
+            }
+        }
+        return bytes;
+    }
+    
+    // First UTF-8 code point of a name, matching left(full_name, 1) on a
+    // UTF-8 database; a lead byte is followed by its continuation bytes
+    std::string firstCharacter(const std::string& name) {
+        if (name.empty()) {
+            return name;
+        }
+        std::size_t length = 1;
+        while (length < name.size() && (static_cast<unsigned char>(name[length]) & 0xC0) == 0x80) {
+            ++length;
+        }
+        return name.substr(0, length);
+    }
+}
+
+AggregateReport DatabaseManager::buildAggregateReport(int parallelWorkers) {
+    AggregateReport report;
+    
+    try {
+        pqxx::work txn(*conn);
+        // Cheaper parallel setup so the planner picks a Parallel Seq/Index Scan
+        // with partial aggregation even on a single-million-row table
+        txn.exec("SET LOCAL max_parallel_workers_per_gather = " + std::to_string(parallelWorkers));
+        txn.exec("SET LOCAL parallel_setup_cost = 100");
+        txn.exec("SET LOCAL parallel_tuple_cost = 0.01");
+        
+        // One scan grouped by (gender, initial, age band); both summaries are rolled up from it
+        const std::string groupedQuery = R"(
+            SELECT gender, left(full_name, 1) AS initial,
+                   EXTRACT(YEAR FROM AGE(birth_date))::int / 10 AS band,
+                   COUNT(*) AS total
+            FROM employees
+            GROUP BY gender, initial, band
+        )";
+        
+        pqxx::result plan = txn.exec("EXPLAIN " + groupedQuery);
+        std::regex workersPattern(R"(Workers Planned: (\d+))");
+        for (const auto& row : plan) {
+            std::smatch match;
+            std::string line = row[0].as<std::string>();
+            if (std::regex_search(line, match, workersPattern)) {
+                report.workersPlanned = std::max(report.workersPlanned, std::stoi(match[1].str()));
+            }
+        }
+        
+        pqxx::result grouped = txn.exec(groupedQuery);
+        for (const auto& row : grouped) {
+            long long total = row[3].as<long long>();
+            report.byGenderInitial[{row[0].as<std::string>(), row[1].as<std::string>()}] += total;
+            report.ageBands[row[2].as<int>()] += total;
+            report.totalRows += total;
+        }
+        
+        pqxx::result duplicates = txn.exec(R"(
+            SELECT COUNT(*), COALESCE(SUM(copies - 1), 0)
+            FROM (
+                SELECT COUNT(*) AS copies
+                FROM employees
+                GROUP BY full_name, birth_date
+                HAVING COUNT(*) > 1
+            ) d
+        )");
+        report.duplicateGroups = duplicates[0][0].as<long long>();
+        report.duplicateRows = duplicates[0][1].as<long long>();
+        
+        report.rowsTransferred = static_cast<long long>(grouped.size() + duplicates.size());
+        report.wireBytes = resultWireBytes(grouped) + resultWireBytes(duplicates);
+        
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error building aggregate report: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return report;
+}
+
+AggregateReport DatabaseManager::buildAggregateReportClientSide() {
+    AggregateReport report;
+    
+    try {
+        pqxx::work txn(*conn);
+        pqxx::result res = txn.exec(R"(
+            SELECT full_name, birth_date, gender,
+                   EXTRACT(YEAR FROM AGE(birth_date))::int AS age
+            FROM employees
+        )");
+        txn.commit();
+        
+        std::map<std::pair<std::string, std::string>, long long> copies;
+        for (const auto& row : res) {
+            std::string fullName = row[0].as<std::string>();
+            std::string birthDate = row[1].as<std::string>();
+            std::string gender = row[2].as<std::string>();
+            int age = row[3].as<int>();
+            
+            report.byGenderInitial[{gender, firstCharacter(fullName)}]++;
+            report.ageBands[age / 10]++;
+            copies[{std::move(fullName), std::move(birthDate)}]++;
+        }
+        for (const auto& entry : copies) {
+            if (entry.second > 1) {
+                report.duplicateGroups++;
+                report.duplicateRows += entry.second - 1;
+            }
+        }
+        
+        report.totalRows = static_cast<long long>(res.size());
+        report.rowsTransferred = report.totalRows;
+        report.wireBytes = resultWireBytes(res);
+    } catch (const std::exception& e) {
+        std::cerr << "Error building client-side report: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return report;
+}
+
+const double DatabaseManager::DEFAULT_FUZZY_THRESHOLD = 0.5;
+
+namespace {
+    // Escapes LIKE wildcards so the search term is matched literally
+    std::string escapeLikePattern(const std::string& term) {
+        std::string escaped;
+        escaped.reserve(term.size());
+        for (char c : term) {
+            if (c == '\\' || c == '%' || c == '_') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+void DatabaseManager::createTrigramIndex(const std::string& table) {
+    try {
+        pqxx::work txn(*conn);
+        txn.exec("CREATE EXTENSION IF NOT EXISTS pg_trgm");
+        // GIN rather than GiST: the table is read-mostly and GIN lookups are
+        // faster for both ILIKE and the word-similarity operator
+        txn.exec("CREATE INDEX IF NOT EXISTS " + txn.quote_name("idx_" + table + "_name_trgm") +
+                 " ON " + txn.quote_name(table) + " USING gin (full_name gin_trgm_ops)");
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error creating trigram index: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+std::vector<std::tuple<std::string, std::string, std::string, int, double>>
+DatabaseManager::searchEmployeesByName(const std::string& term, NameMatch match, int limit,
+                                       double fuzzyThreshold, const std::string& table) {
+    std::vector<std::tuple<std::string, std::string, std::string, int, double>> result;
+    
+    try {
+        pqxx::work txn(*conn);
+        
+        std::string score;
+        std::string condition;
+        if (match == NameMatch::SUBSTRING) {
+            score = "similarity(full_name, $1)";
+            condition = "full_name ILIKE '%' || $2 || '%'";
+        } else {
+            // <% uses pg_trgm.word_similarity_threshold, which is scoped to this transaction
+            txn.exec("SET LOCAL pg_trgm.word_similarity_threshold = " + std::to_string(fuzzyThreshold));
+            score = "word_similarity($1, full_name)";
+            condition = "$1 <% full_name";
+        }
+        
+        std::ostringstream query;
+        query << "SELECT full_name, birth_date, gender, age, score FROM ("
+              << "SELECT DISTINCT ON (full_name, birth_date) "
+              << "full_name, birth_date, gender, "
+              << "EXTRACT(YEAR FROM AGE(birth_date))::int AS age, "
+              << score << "::float8 AS score "
+              << "FROM " << txn.quote_name(table) << " "
+              << "WHERE " << condition << " "
+              << "ORDER BY full_name, birth_date"
+              << ") matches "
+              << "ORDER BY score DESC, full_name, birth_date "
+              << "LIMIT " << limit;
+        
+        pqxx::result res = match == NameMatch::SUBSTRING
+            ? txn.exec_params(query.str(), term, escapeLikePattern(term))
+            : txn.exec_params(query.str(), term);
+        
+        for (const auto& row : res) {
+            result.emplace_back(row[0].as<std::string>(), row[1].as<std::string>(),
+                                row[2].as<std::string>(), row[3].as<int>(), row[4].as<double>());
+        }
+        
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Error searching employees by name: " << e.what() << std::endl;
+        throw;
+    }
+    
+    return result;
+}
+
 pqxx::connection* DatabaseManager::getConnection() {
     return conn;
 }
+
+BinaryConnection& DatabaseManager::getBinaryConnection() {
+    if (!binaryConn) {
+        binaryConn = std::make_unique<BinaryConnection>(connectionString);
+        binaryConn->execute("SET plan_cache_mode = force_custom_plan");
+        for (const auto& setting : sessionSettings) {
+            binaryConn->execute(setting);
+        }
+    }
+    return *binaryConn;
+}
+
+void DatabaseManager::prepareViewStatements() {
+    try {
+        BinaryConnection& binary = getBinaryConnection();
+        binary.prepare("all_employees", ALL_EMPLOYEE_VIEWS_SQL, 0);
+        binary.prepare("employees_by_criteria", EMPLOYEE_VIEWS_BY_CRITERIA_SQL, 2);
+    } catch (const std::exception& e) {
+        std::cerr << "Error preparing view statements: " << e.what() << std::endl;
+        throw;
+    }
+}
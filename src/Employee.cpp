@@ -9,15 +9,15 @@
 Employee::Employee(const std::string& name, const std::string& date, const std::string& gen)
     : fullName(name), birthDate(date), gender(gen) {}
 
-std::string Employee::getFullName() const {
+const std::string& Employee::getFullName() const {
     return fullName;
 }
 
-std::string Employee::getBirthDate() const {
+const std::string& Employee::getBirthDate() const {
     return birthDate;
 }
 
-std::string Employee::getGender() const {
+const std::string& Employee::getGender() const {
     return gender;
 }
 
@@ -0,0 +1,185 @@
+#include "EmployeeRowView.h"
+
+#include <algorithm>
+#include <climits>
+#include <libpq-fe.h>
+#include <stdexcept>
+
+namespace {
+    const Oid DATE_OID = 1082;
+    const Oid INT4_OID = 23;
+    
+    // PostgreSQL dates count from 2000-01-01, which is day 10957 of the Unix epoch
+    const std::int32_t POSTGRES_EPOCH_UNIX_DAYS = 10957;
+    
+    std::int32_t readInt32(const char* data) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return static_cast<std::int32_t>((static_cast<std::uint32_t>(bytes[0]) << 24) |
+                                         (static_cast<std::uint32_t>(bytes[1]) << 16) |
+                                         (static_cast<std::uint32_t>(bytes[2]) << 8) |
+                                         static_cast<std::uint32_t>(bytes[3]));
+    }
+    
+    // Special DATE values for -infinity and infinity
+    const std::int32_t DATEVAL_NOBEGIN = INT32_MIN;
+    const std::int32_t DATEVAL_NOEND = INT32_MAX;
+    
+    void writeDigits(char* out, std::int64_t value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+    
+    EmployeeResultSet takeResult(PGresult* result, PGconn* conn) {
+        if (!result || PQresultStatus(result) != PGRES_TUPLES_OK) {
+            std::string message = result ? PQresultErrorMessage(result) : PQerrorMessage(conn);
+            PQclear(result);
+            throw std::runtime_error(message);
+        }
+        return EmployeeResultSet(result);
+    }
+}
+
+std::string_view EmployeeView::birthDate(char (&buffer)[DATE_BUFFER_SIZE]) const {
+    if (birthDays == DATEVAL_NOBEGIN) {
+        return "-infinity";
+    }
+    if (birthDays == DATEVAL_NOEND) {
+        return "infinity";
+    }
+    
+    // Civil-from-days conversion (proleptic Gregorian calendar)
+    std::int64_t z = static_cast<std::int64_t>(birthDays) + POSTGRES_EPOCH_UNIX_DAYS + 719468;
+    std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    std::int64_t dayOfEra = z - era * 146097;
+    std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    std::int64_t monthPrime = (5 * dayOfYear + 2) / 153;
+    int day = static_cast<int>(dayOfYear - (153 * monthPrime + 2) / 5 + 1);
+    int month = static_cast<int>(monthPrime < 10 ? monthPrime + 3 : monthPrime - 9);
+    std::int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    
+    // Astronomical year 0 is 1 BC; the server pads years to at least 4 digits
+    bool beforeCommonEra = year <= 0;
+    std::int64_t shownYear = beforeCommonEra ? 1 - year : year;
+    int yearWidth = 4;
+    for (std::int64_t rest = shownYear / 10000; rest > 0; rest /= 10) {
+        ++yearWidth;
+    }
+    
+    char* out = buffer;
+    writeDigits(out, shownYear, yearWidth);
+    out += yearWidth;
+    *out++ = '-';
+    writeDigits(out, month, 2);
+    out += 2;
+    *out++ = '-';
+    writeDigits(out, day, 2);
+    out += 2;
+    if (beforeCommonEra) {
+        *out++ = ' ';
+        *out++ = 'B';
+        *out++ = 'C';
+    }
+    *out = '\0';
+    return std::string_view(buffer, static_cast<std::size_t>(out - buffer));
+}
+
+EmployeeResultSet::EmployeeResultSet(pg_result* result_) : result(result_), rowCount(0) {
+    if (PQnfields(result) != 4 ||
+        PQfformat(result, 1) != 1 || PQftype(result, 1) != DATE_OID ||
+        PQfformat(result, 3) != 1 || PQftype(result, 3) != INT4_OID) {
+        PQclear(result);
+        throw std::runtime_error("Unexpected result layout: expected binary (full_name, birth_date date, gender, age int4)");
+    }
+    rowCount = PQntuples(result);
+}
+
+EmployeeResultSet::~EmployeeResultSet() {
+    PQclear(result);
+}
+
+EmployeeResultSet::EmployeeResultSet(EmployeeResultSet&& other) noexcept
+    : result(other.result), rowCount(other.rowCount) {
+    other.result = nullptr;
+    other.rowCount = 0;
+}
+
+EmployeeResultSet& EmployeeResultSet::operator=(EmployeeResultSet&& other) noexcept {
+    if (this != &other) {
+        PQclear(result);
+        result = other.result;
+        rowCount = other.rowCount;
+        other.result = nullptr;
+        other.rowCount = 0;
+    }
+    return *this;
+}
+
+EmployeeView EmployeeResultSet::operator[](std::size_t row) const {
+    int r = static_cast<int>(row);
+    EmployeeView view;
+    view.fullName = std::string_view(PQgetvalue(result, r, 0), static_cast<std::size_t>(PQgetlength(result, r, 0)));
+    view.birthDays = readInt32(PQgetvalue(result, r, 1));
+    view.gender = std::string_view(PQgetvalue(result, r, 2), static_cast<std::size_t>(PQgetlength(result, r, 2)));
+    view.age = readInt32(PQgetvalue(result, r, 3));
+    return view;
+}
+
+BinaryConnection::BinaryConnection(const std::string& connectionString) : conn(PQconnectdb(connectionString.c_str())) {
+    if (PQstatus(conn) != CONNECTION_OK) {
+        std::string message = PQerrorMessage(conn);
+        PQfinish(conn);
+        throw std::runtime_error(message);
+    }
+}
+
+BinaryConnection::~BinaryConnection() {
+    PQfinish(conn);
+}
+
+void BinaryConnection::execute(const std::string& sql) {
+    PGresult* result = PQexec(conn, sql.c_str());
+    ExecStatusType status = result ? PQresultStatus(result) : PGRES_FATAL_ERROR;
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+        std::string message = result ? PQresultErrorMessage(result) : PQerrorMessage(conn);
+        PQclear(result);
+        throw std::runtime_error(message);
+    }
+    PQclear(result);
+}
+
+void BinaryConnection::prepare(const std::string& name, const std::string& sql, int paramCount) {
+    if (std::find(preparedNames.begin(), preparedNames.end(), name) != preparedNames.end()) {
+        return;
+    }
+    PGresult* prepared = PQprepare(conn, name.c_str(), sql.c_str(), paramCount, nullptr);
+    if (!prepared || PQresultStatus(prepared) != PGRES_COMMAND_OK) {
+        std::string message = prepared ? PQresultErrorMessage(prepared) : PQerrorMessage(conn);
+        PQclear(prepared);
+        throw std::runtime_error(message);
+    }
+    PQclear(prepared);
+    preparedNames.push_back(name);
+}
+
+EmployeeResultSet BinaryConnection::queryEmployees(const std::string& name, const std::string& sql,
+                                                   const std::vector<std::string>& params) {
+    prepare(name, sql, static_cast<int>(params.size()));
+    
+    std::vector<const char*> values;
+    values.reserve(params.size());
+    for (const auto& param : params) {
+        values.push_back(param.c_str());
+    }
+    
+    PGresult* result = PQexecPrepared(conn, name.c_str(), static_cast<int>(values.size()),
+                                      values.data(), nullptr, nullptr, 1);
+    return takeResult(result, conn);
+}
+
+EmployeeResultSet BinaryConnection::queryEmployees(const std::string& sql) {
+    PGresult* result = PQexecParams(conn, sql.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+    return takeResult(result, conn);
+}
@@ -3,7 +3,36 @@
 #include <ctime>
 
 namespace {
-    std::string generateRandomName(char startingLetter = '\0') {
+    // Small, cheap-to-seed engine for per-row deterministic generation
+    struct SplitMix64 {
+        using result_type = std::uint64_t;
+        std::uint64_t state;
+        
+        explicit SplitMix64(std::uint64_t seed) : state(seed) {}
+        
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~result_type(0); }
+        
+        result_type operator()() {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+    };
+    
+    SplitMix64 rowEngine(std::uint64_t seed, long long row) {
+        SplitMix64 mixer(seed ^ (static_cast<std::uint64_t>(row) * 0xD1B54A32D192ED03ULL));
+        return SplitMix64(mixer());
+    }
+    
+    std::mt19937& sharedEngine() {
+        static std::mt19937 gen(static_cast<unsigned>(std::time(nullptr)));
+        return gen;
+    }
+    
+    template <typename Engine>
+    std::string generateRandomName(Engine& gen, char startingLetter = '\0') {
         static const char* surnames[] = {
             "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis",
             "Rodriguez", "Martinez", "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson",
@@ -26,8 +55,6 @@ namespace {
             "Timothy", "Victor", "Walter", "Xavier", "Zachary", "Ann", "Marie"
         };
         
-        static std::mt19937 gen(static_cast<unsigned>(std::time(nullptr)));
-        
         std::string surname;
         if (startingLetter != '\0') {
             std::vector<std::string> matchingSurnames;
@@ -53,8 +80,8 @@ namespace {
         return surname + " " + firstNames[firstNamesDist(gen)] + " " + middleNames[middleNamesDist(gen)];
     }
     
-    std::string generateRandomDate() {
-        static std::mt19937 gen(static_cast<unsigned>(std::time(nullptr)));
+    template <typename Engine>
+    std::string generateRandomDate(Engine& gen) {
         std::uniform_int_distribution<> yearDist(1950, 2005);
         std::uniform_int_distribution<> monthDist(1, 12);
         std::uniform_int_distribution<> dayDist(1, 28);
@@ -68,9 +95,9 @@ namespace {
         return std::string(buffer);
     }
     
-    std::string generateRandomGender() {
-        static std::mt19937 gen(static_cast<unsigned>(std::time(nullptr)));
-        static std::uniform_int_distribution<> dist(0, 1);
+    template <typename Engine>
+    std::string generateRandomGender(Engine& gen) {
+        std::uniform_int_distribution<> dist(0, 1);
         return (dist(gen) == 0) ? "Male" : "Female";
     }
 }
@@ -79,12 +106,25 @@ std::vector<Employee> RandomDataGenerator::generateEmployees(int count) {
     std::vector<Employee> employees;
     employees.reserve(count);
     
+    auto& gen = sharedEngine();
+    for (int i = 0; i < count; ++i) {
+        std::string name = generateRandomName(gen);
+        std::string date = generateRandomDate(gen);
+        employees.emplace_back(name, date, generateRandomGender(gen));
+    }
+    
+    return employees;
+}
+
+std::vector<Employee> RandomDataGenerator::generateRange(std::uint64_t seed, long long firstRow, int count) {
+    std::vector<Employee> employees;
+    employees.reserve(count);
+    
     for (int i = 0; i < count; ++i) {
-        employees.emplace_back(
-            generateRandomName(),
-            generateRandomDate(),
-            generateRandomGender()
-        );
+        SplitMix64 gen = rowEngine(seed, firstRow + i);
+        std::string name = generateRandomName(gen);
+        std::string date = generateRandomDate(gen);
+        employees.emplace_back(name, date, generateRandomGender(gen));
     }
     
     return employees;
@@ -97,12 +137,23 @@ std::vector<Employee> TargetedDataGenerator::generateEmployees(int count) {
     std::vector<Employee> employees;
     employees.reserve(count);
     
+    auto& gen = sharedEngine();
+    for (int i = 0; i < count; ++i) {
+        std::string name = generateRandomName(gen, startingLetter);
+        employees.emplace_back(name, generateRandomDate(gen), gender);
+    }
+    
+    return employees;
+}
+
+std::vector<Employee> TargetedDataGenerator::generateRange(std::uint64_t seed, long long firstRow, int count) {
+    std::vector<Employee> employees;
+    employees.reserve(count);
+    
     for (int i = 0; i < count; ++i) {
-        employees.emplace_back(
-            generateRandomName(startingLetter),
-            generateRandomDate(),
-            gender
-        );
+        SplitMix64 gen = rowEngine(seed, firstRow + i);
+        std::string name = generateRandomName(gen, startingLetter);
+        employees.emplace_back(name, generateRandomDate(gen), gender);
     }
     
     return employees;
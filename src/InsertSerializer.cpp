@@ -0,0 +1,58 @@
+#include "InsertSerializer.h"
+#include "Employee.h"
+
+namespace {
+    // Rough upper estimate of one serialized row: name, date, gender and quoting
+    const std::size_t BYTES_PER_ROW_ESTIMATE = 96;
+}
+
+InsertSerializer::InsertSerializer(std::size_t chunkRows_)
+    : prefixLength(0), chunkRows(chunkRows_ > 0 ? chunkRows_ : 1), rowsInChunk(0) {
+    buffer.reserve(128 + chunkRows * BYTES_PER_ROW_ESTIMATE);
+    setTable("employees");
+}
+
+void InsertSerializer::setTable(const std::string& table) {
+    buffer.clear();
+    buffer.append("INSERT INTO ").append(table).append(" (full_name, birth_date, gender) VALUES ");
+    prefixLength = buffer.size();
+    rowsInChunk = 0;
+}
+
+void InsertSerializer::appendLiteral(std::string_view value) {
+    // E'' literals are interpreted the same way regardless of the server's
+    // standard_conforming_strings setting, so only quotes and backslashes
+    // need doubling.
+    buffer.append("E'");
+    for (char c : value) {
+        if (c == '\'' || c == '\\') {
+            buffer.push_back(c);
+        }
+        buffer.push_back(c);
+    }
+    buffer.push_back('\'');
+}
+
+void InsertSerializer::append(const Employee& employee) {
+    append(employee.getFullName(), employee.getBirthDate(), employee.getGender());
+}
+
+void InsertSerializer::append(std::string_view fullName, std::string_view birthDate,
+                              std::string_view gender) {
+    if (rowsInChunk > 0) {
+        buffer.append(", ");
+    }
+    buffer.push_back('(');
+    appendLiteral(fullName);
+    buffer.append(", ");
+    appendLiteral(birthDate);
+    buffer.append(", ");
+    appendLiteral(gender);
+    buffer.push_back(')');
+    ++rowsInChunk;
+}
+
+void InsertSerializer::reset() {
+    buffer.resize(prefixLength);
+    rowsInChunk = 0;
+}
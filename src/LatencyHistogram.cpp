@@ -0,0 +1,84 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    int leadingZeros(std::uint64_t value) {
+        return value == 0 ? 64 : __builtin_clzll(value);
+    }
+}
+
+LatencyHistogram::LatencyHistogram(std::int64_t highestTrackableMicros)
+    : highestTrackable(std::max<std::int64_t>(highestTrackableMicros, 2 * SUB_BUCKET_COUNT)),
+      totalCount(0), minValue(0), maxValue(0), sum(0.0) {
+    int bucketCount = 1;
+    std::int64_t smallestUntrackable = SUB_BUCKET_COUNT;
+    while (smallestUntrackable <= highestTrackable) {
+        smallestUntrackable <<= 1;
+        ++bucketCount;
+    }
+    counts.assign(static_cast<std::size_t>((bucketCount + 1) * SUB_BUCKET_HALF_COUNT), 0);
+}
+
+std::size_t LatencyHistogram::indexFor(std::int64_t value) const {
+    int bucketIndex = (64 - SUB_BUCKET_BITS) - leadingZeros(static_cast<std::uint64_t>(value | SUB_BUCKET_MASK));
+    std::int64_t subBucketIndex = value >> bucketIndex;
+    return static_cast<std::size_t>(((static_cast<std::int64_t>(bucketIndex) + 1) << (SUB_BUCKET_BITS - 1)) +
+                                    (subBucketIndex - SUB_BUCKET_HALF_COUNT));
+}
+
+std::int64_t LatencyHistogram::highestEquivalentValue(std::size_t index) const {
+    std::int64_t bucketIndex = static_cast<std::int64_t>(index >> (SUB_BUCKET_BITS - 1)) - 1;
+    std::int64_t subBucketIndex = static_cast<std::int64_t>(index & (SUB_BUCKET_HALF_COUNT - 1)) + SUB_BUCKET_HALF_COUNT;
+    if (bucketIndex < 0) {
+        subBucketIndex -= SUB_BUCKET_HALF_COUNT;
+        bucketIndex = 0;
+    }
+    std::int64_t lowest = subBucketIndex << bucketIndex;
+    return lowest + (std::int64_t(1) << bucketIndex) - 1;
+}
+
+void LatencyHistogram::record(std::int64_t micros) {
+    std::int64_t value = std::min(std::max<std::int64_t>(micros, 0), highestTrackable);
+    ++counts[indexFor(value)];
+    if (totalCount == 0 || value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+    ++totalCount;
+    sum += static_cast<double>(value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.counts.size() != counts.size()) {
+        throw std::invalid_argument("Cannot merge histograms with different ranges");
+    }
+    if (other.totalCount == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    if (totalCount == 0 || other.minValue < minValue) minValue = other.minValue;
+    maxValue = std::max(maxValue, other.maxValue);
+    totalCount += other.totalCount;
+    sum += other.sum;
+}
+
+std::int64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (totalCount == 0) {
+        return 0;
+    }
+    double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    std::int64_t target = static_cast<std::int64_t>(std::ceil(clamped / 100.0 * totalCount));
+    target = std::max<std::int64_t>(target, 1);
+    
+    std::int64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(highestEquivalentValue(i), maxValue);
+        }
+    }
+    return maxValue;
+}
@@ -0,0 +1,117 @@
+#include "LocalProtocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    bool writeAll(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+    
+    bool readAll(int fd, char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t received = ::read(fd, data, size);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (received == 0) {
+                return false;
+            }
+            data += received;
+            size -= static_cast<std::size_t>(received);
+        }
+        return true;
+    }
+}
+
+namespace LocalProtocol {
+
+void encodeHeader(std::uint32_t length, unsigned char* header) {
+    header[0] = static_cast<unsigned char>(length >> 24);
+    header[1] = static_cast<unsigned char>(length >> 16);
+    header[2] = static_cast<unsigned char>(length >> 8);
+    header[3] = static_cast<unsigned char>(length);
+}
+
+std::uint32_t decodeHeader(const unsigned char* header) {
+    return (static_cast<std::uint32_t>(header[0]) << 24) |
+           (static_cast<std::uint32_t>(header[1]) << 16) |
+           (static_cast<std::uint32_t>(header[2]) << 8) |
+           static_cast<std::uint32_t>(header[3]);
+}
+
+void appendFrame(std::string& out, const std::string& payload) {
+    unsigned char header[HEADER_SIZE];
+    encodeHeader(static_cast<std::uint32_t>(payload.size()), header);
+    out.append(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    out.append(payload);
+}
+
+bool writeFrame(int fd, const std::string& payload) {
+    unsigned char header[HEADER_SIZE];
+    encodeHeader(static_cast<std::uint32_t>(payload.size()), header);
+    return writeAll(fd, reinterpret_cast<const char*>(header), HEADER_SIZE) &&
+           writeAll(fd, payload.data(), payload.size());
+}
+
+bool readFrame(int fd, std::string& payload) {
+    unsigned char header[HEADER_SIZE];
+    if (!readAll(fd, reinterpret_cast<char*>(header), HEADER_SIZE)) {
+        return false;
+    }
+    payload.resize(decodeHeader(header));
+    return readAll(fd, &payload[0], payload.size());
+}
+
+int connectTo(const std::string& socketPath) {
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socketPath);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot connect to " + socketPath + ": " + std::strerror(error));
+    }
+    return fd;
+}
+
+std::string joinRequest(const std::string* begin, const std::string* end) {
+    std::string request;
+    for (const std::string* word = begin; word != end; ++word) {
+        if (!request.empty()) {
+            request.push_back(' ');
+        }
+        if (word->empty() || word->find_first_of(" \t") != std::string::npos) {
+            request.push_back('"');
+            request.append(*word);
+            request.push_back('"');
+        } else {
+            request.append(*word);
+        }
+    }
+    return request;
+}
+
+}
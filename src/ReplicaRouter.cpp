@@ -0,0 +1,106 @@
+#include "ReplicaRouter.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+ReplicaRouter::ReplicaRouter(DatabaseManager& primary_, const std::string& primaryName, Policy policy_)
+    : primary(primary_), policy(policy_), nextReplica(0), checkInterval(std::chrono::seconds(5)) {
+    Endpoint entry;
+    entry.stats.name = primaryName;
+    entry.stats.role = "primary";
+    entry.stats.healthy = true;
+    endpoints.push_back(std::move(entry));
+}
+
+ReplicaRouter::~ReplicaRouter() = default;
+
+ReplicaRouter::Policy ReplicaRouter::parsePolicy(const std::string& name) {
+    if (name == "round-robin") return Policy::ROUND_ROBIN;
+    if (name == "least-latency") return Policy::LEAST_LATENCY;
+    throw std::invalid_argument("Unknown read routing policy: " + name +
+                                " (expected round-robin or least-latency)");
+}
+
+void ReplicaRouter::addReplica(const std::string& name, std::unique_ptr<DatabaseManager> replica) {
+    Endpoint entry;
+    entry.db = std::move(replica);
+    entry.stats.name = name;
+    entry.stats.role = "replica";
+    endpoints.push_back(std::move(entry));
+    checkEndpoint(endpoints.back());
+}
+
+DatabaseManager& ReplicaRouter::managerFor(Endpoint& endpoint) {
+    return endpoint.db ? *endpoint.db : primary;
+}
+
+void ReplicaRouter::recordLatency(EndpointStats& stats, double ms) {
+    const double smoothing = 0.2;
+    stats.ewmaMs = (stats.reads == 0 && stats.ewmaMs == 0.0) ? ms : stats.ewmaMs + smoothing * (ms - stats.ewmaMs);
+    stats.totalMs += ms;
+    stats.minMs = (stats.reads == 0) ? ms : std::min(stats.minMs, ms);
+    stats.maxMs = std::max(stats.maxMs, ms);
+}
+
+void ReplicaRouter::checkEndpoint(Endpoint& endpoint) {
+    endpoint.lastCheck = std::chrono::steady_clock::now();
+    DatabaseManager& db = managerFor(endpoint);
+    
+    try {
+        if (!db.getConnection()) {
+            db.connect();
+        }
+        auto start = std::chrono::steady_clock::now();
+        {
+            pqxx::nontransaction txn(*db.getConnection());
+            endpoint.stats.inRecovery = txn.exec1("SELECT pg_is_in_recovery()")[0].as<bool>();
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        endpoint.stats.lastCheckMs = ms;
+        const double smoothing = 0.2;
+        endpoint.stats.ewmaMs = endpoint.stats.ewmaMs == 0.0 ? ms : endpoint.stats.ewmaMs + smoothing * (ms - endpoint.stats.ewmaMs);
+        
+        if (endpoint.db && !endpoint.stats.inRecovery) {
+            std::cerr << "Warning: replica " << endpoint.stats.name
+                      << " is not in recovery (promoted or misconfigured)" << std::endl;
+        }
+        endpoint.stats.healthy = true;
+    } catch (const std::exception& e) {
+        if (endpoint.stats.healthy || endpoint.stats.failures == 0) {
+            std::cerr << "Health check failed for " << endpoint.stats.name << ": " << e.what() << std::endl;
+        }
+        ++endpoint.stats.failures;
+        // The primary stays the fallback for reads even when its check fails
+        endpoint.stats.healthy = !endpoint.db;
+        if (endpoint.db) {
+            endpoint.db->disconnect();
+        }
+    }
+}
+
+void ReplicaRouter::healthCheck() {
+    for (auto& endpoint : endpoints) {
+        checkEndpoint(endpoint);
+    }
+}
+
+void ReplicaRouter::applySessionSetting(const std::string& sql) {
+    for (std::size_t i = 1; i < endpoints.size(); ++i) {
+        try {
+            endpoints[i].db->applySessionSetting(sql);
+        } catch (const std::exception& e) {
+            std::cerr << "Could not apply '" << sql << "' on " << endpoints[i].stats.name
+                      << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+std::vector<ReplicaRouter::EndpointStats> ReplicaRouter::stats() const {
+    std::vector<EndpointStats> result;
+    for (const auto& endpoint : endpoints) {
+        result.push_back(endpoint.stats);
+    }
+    return result;
+}
@@ -0,0 +1,211 @@
+#include "ShardedDatabase.h"
+#include "DatabaseManager.h"
+#include "Employee.h"
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    
+    // Shards sort with COLLATE "C" so that their order matches the byte-wise
+    // comparison used by the client-side merge, whatever the database collation
+    const char* const ALL_EMPLOYEES_SQL = R"(
+            SELECT DISTINCT ON (full_name COLLATE "C", birth_date)
+                full_name, birth_date, gender,
+                EXTRACT(YEAR FROM AGE(birth_date))::int4 as age
+            FROM employees
+            ORDER BY full_name COLLATE "C", birth_date
+        )";
+    
+    const char* const CRITERIA_SQL = R"(
+            SELECT full_name, birth_date, gender,
+                   EXTRACT(YEAR FROM AGE(birth_date))::int4 as age
+            FROM employees
+            WHERE gender = $1
+              AND full_name LIKE $2
+            ORDER BY full_name COLLATE "C"
+        )";
+}
+
+ShardedDatabase::ShardedDatabase() = default;
+
+ShardedDatabase::~ShardedDatabase() = default;
+
+void ShardedDatabase::addShard(const std::string& name, std::unique_ptr<DatabaseManager> shard) {
+    names.push_back(name);
+    shards.push_back(std::move(shard));
+}
+
+std::size_t ShardedDatabase::shardFor(const std::string& fullName, std::size_t shardCount) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : fullName) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(hash % shardCount);
+}
+
+void ShardedDatabase::connectAll() {
+    if (shards.empty()) {
+        throw std::runtime_error("No shards configured (Config::DB_SHARDS is empty)");
+    }
+    std::vector<std::future<void>> pending;
+    for (auto& shard : shards) {
+        if (!shard->getConnection()) {
+            pending.push_back(std::async(std::launch::async, [&shard] { shard->connect(); }));
+        }
+    }
+    for (auto& connection : pending) {
+        connection.get();
+    }
+}
+
+std::vector<ShardedDatabase::ShardTiming> ShardedDatabase::createTable() {
+    std::vector<std::future<ShardTiming>> pending;
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        pending.push_back(std::async(std::launch::async, [this, i] {
+            ShardTiming timing;
+            timing.name = names[i];
+            auto start = Clock::now();
+            shards[i]->createTable();
+            timing.ms = elapsedMs(start);
+            return timing;
+        }));
+    }
+    std::vector<ShardTiming> timings;
+    for (auto& result : pending) {
+        timings.push_back(result.get());
+    }
+    return timings;
+}
+
+std::string ShardedDatabase::insertEmployee(const std::string& fullName, const std::string& birthDate,
+                                            const std::string& gender) {
+    std::size_t shard = shardFor(fullName, shards.size());
+    shards[shard]->insertEmployee(fullName, birthDate, gender);
+    return names[shard];
+}
+
+std::vector<ShardedDatabase::ShardTiming> ShardedDatabase::batchInsertEmployees(const std::vector<Employee>& employees) {
+    std::vector<std::vector<Employee>> partitions(shards.size());
+    for (auto& partition : partitions) {
+        partition.reserve(employees.size() / shards.size() + 1);
+    }
+    for (const auto& employee : employees) {
+        partitions[shardFor(employee.getFullName(), shards.size())].push_back(employee);
+    }
+    
+    std::vector<std::future<ShardTiming>> pending;
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        pending.push_back(std::async(std::launch::async, [this, i, &partitions] {
+            ShardTiming timing;
+            timing.name = names[i];
+            timing.rows = static_cast<long long>(partitions[i].size());
+            auto start = Clock::now();
+            // Shard threads stay silent; the outcome is reported once all have joined
+            if (!partitions[i].empty()) {
+                shards[i]->insertEmployeesSilently(partitions[i]);
+            }
+            timing.ms = elapsedMs(start);
+            return timing;
+        }));
+    }
+    std::vector<ShardTiming> timings;
+    std::exception_ptr firstError;
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        try {
+            timings.push_back(pending[i].get());
+        } catch (const std::exception& e) {
+            std::cerr << "Error in batch insert on shard " << names[i] << ": " << e.what() << std::endl;
+            if (!firstError) {
+                firstError = std::current_exception();
+            }
+        }
+    }
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+    std::cout << "Batch insert completed: " << employees.size() << " employees added across "
+              << shards.size() << " shards" << std::endl;
+    return timings;
+}
+
+ShardedDatabase::MergedResult ShardedDatabase::scatterGather(const std::string& statementName, const std::string& sql,
+                                                             const std::vector<std::string>& params, bool byBirthDate) {
+    MergedResult merged;
+    
+    std::vector<std::future<std::pair<EmployeeResultSet, double>>> pending;
+    for (auto& shard : shards) {
+        DatabaseManager* db = shard.get();
+        pending.push_back(std::async(std::launch::async, [db, &statementName, &sql, &params] {
+            auto start = Clock::now();
+            EmployeeResultSet rows = db->getBinaryConnection().queryEmployees(statementName, sql, params);
+            return std::make_pair(std::move(rows), elapsedMs(start));
+        }));
+    }
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        auto result = pending[i].get();
+        ShardTiming timing;
+        timing.name = names[i];
+        timing.rows = static_cast<long long>(result.first.size());
+        timing.ms = result.second;
+        merged.shards.push_back(timing);
+        merged.parts.push_back(std::move(result.first));
+    }
+    
+    auto mergeStart = Clock::now();
+    
+    // Heap of (shard, row) cursors ordered by the current row of each shard
+    struct Cursor {
+        std::size_t part;
+        std::size_t row;
+        EmployeeView view;
+    };
+    auto after = [byBirthDate](const Cursor& a, const Cursor& b) {
+        if (a.view.fullName != b.view.fullName) {
+            return a.view.fullName > b.view.fullName;
+        }
+        return byBirthDate && a.view.birthDays > b.view.birthDays;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> heap(after);
+    
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < merged.parts.size(); ++i) {
+        total += merged.parts[i].size();
+        if (!merged.parts[i].empty()) {
+            heap.push({i, 0, merged.parts[i][0]});
+        }
+    }
+    
+    merged.rows.reserve(total);
+    while (!heap.empty()) {
+        Cursor cursor = heap.top();
+        heap.pop();
+        merged.rows.push_back(cursor.view);
+        if (++cursor.row < merged.parts[cursor.part].size()) {
+            cursor.view = merged.parts[cursor.part][cursor.row];
+            heap.push(cursor);
+        }
+    }
+    
+    merged.mergeMs = elapsedMs(mergeStart);
+    return merged;
+}
+
+ShardedDatabase::MergedResult ShardedDatabase::getAllEmployees() {
+    return scatterGather("sharded_all_employees", ALL_EMPLOYEES_SQL, {}, true);
+}
+
+ShardedDatabase::MergedResult ShardedDatabase::getEmployeesByCriteria(const std::string& gender,
+                                                                      const std::string& lastNameStartsWith) {
+    return scatterGather("sharded_employees_by_criteria", CRITERIA_SQL, {gender, lastNameStartsWith + "%"}, false);
+}
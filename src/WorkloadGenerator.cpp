@@ -0,0 +1,194 @@
+#include "WorkloadGenerator.h"
+#include "DatabaseManager.h"
+#include "IDataGenerator.h"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    const char* OPERATION_NAMES[] = {"read", "write"};
+    
+    long long toMicros(Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+    
+    void printPercentileRow(const char* label, const LatencyHistogram& histogram) {
+        std::cout << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << histogram.count()
+                  << std::setw(10) << histogram.valueAtPercentile(50.0) / 1000.0
+                  << std::setw(10) << histogram.valueAtPercentile(90.0) / 1000.0
+                  << std::setw(10) << histogram.valueAtPercentile(99.0) / 1000.0
+                  << std::setw(10) << histogram.valueAtPercentile(99.9) / 1000.0
+                  << std::setw(10) << histogram.valueAtPercentile(99.99) / 1000.0
+                  << std::setw(10) << histogram.max() / 1000.0
+                  << std::setw(10) << histogram.mean() / 1000.0 << std::endl;
+    }
+}
+
+void WorkloadGenerator::Stats::merge(const Stats& other) {
+    for (int type = 0; type < OPERATION_TYPES; ++type) {
+        responseTime[type].merge(other.responseTime[type]);
+        serviceTime[type].merge(other.serviceTime[type]);
+        errors[type] += other.errors[type];
+        
+        auto& mine = completedPerSecond[type];
+        const auto& theirs = other.completedPerSecond[type];
+        if (mine.size() < theirs.size()) {
+            mine.resize(theirs.size(), 0);
+        }
+        for (std::size_t second = 0; second < theirs.size(); ++second) {
+            mine[second] += theirs[second];
+        }
+    }
+}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadSettings& settings_) : settings(settings_) {
+    if (settings.concurrency < 1) settings.concurrency = 1;
+    if (settings.targetRate <= 0.0) settings.targetRate = 1.0;
+    if (settings.durationSeconds < 1) settings.durationSeconds = 1;
+    if (settings.readPercent < 0) settings.readPercent = 0;
+    if (settings.readPercent > 100) settings.readPercent = 100;
+}
+
+void WorkloadGenerator::run(DatabaseManager& primary) {
+    std::vector<std::unique_ptr<DatabaseManager>> extraConnections;
+    std::vector<DatabaseManager*> connections{&primary};
+    for (int i = 1; i < settings.concurrency; ++i) {
+        extraConnections.push_back(std::make_unique<DatabaseManager>(primary.getConnectionString()));
+        extraConnections.back()->connect();
+        connections.push_back(extraConnections.back().get());
+    }
+    for (auto* db : connections) {
+        db->prepareStatements();
+    }
+    
+    std::cout << "Workload: " << settings.readPercent << "% reads (" << settings.gender
+              << ", '" << settings.lastNamePrefix << "%'), " << (100 - settings.readPercent)
+              << "% inserts, " << settings.targetRate << " ops/s for " << settings.durationSeconds
+              << " s on " << settings.concurrency << " connections" << std::endl;
+    
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / settings.targetRate));
+    const auto start = Clock::now() + std::chrono::milliseconds(100);
+    const auto deadline = start + std::chrono::seconds(settings.durationSeconds);
+    const long long scheduled = static_cast<long long>(settings.targetRate * settings.durationSeconds);
+    
+    std::atomic<long long> nextOperation(0);
+    std::mutex statsMutex;
+    std::mutex generatorMutex;
+    Stats total;
+    
+    auto worker = [&](DatabaseManager& db, unsigned seed) {
+        Stats local;
+        for (auto& perSecond : local.completedPerSecond) {
+            perSecond.assign(static_cast<std::size_t>(settings.durationSeconds) + 1, 0);
+        }
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> percent(0, 99);
+        RandomDataGenerator generator;
+        
+        while (true) {
+            long long i = nextOperation.fetch_add(1);
+            if (i >= scheduled) {
+                break;
+            }
+            const auto intended = start + interval * i;
+            std::this_thread::sleep_until(intended);
+            
+            int type = percent(rng) < settings.readPercent ? READ : WRITE;
+            const auto actual = Clock::now();
+            try {
+                if (type == READ) {
+                    db.getEmployeesByCriteria(settings.gender, settings.lastNamePrefix);
+                } else {
+                    std::vector<Employee> employee;
+                    {
+                        // The data generators share one random engine
+                        std::lock_guard<std::mutex> lock(generatorMutex);
+                        employee = generator.generateEmployees(1);
+                    }
+                    db.insertEmployee(employee[0].getFullName(), employee[0].getBirthDate(),
+                                      employee[0].getGender());
+                }
+            } catch (const std::exception&) {
+                ++local.errors[type];
+                continue;
+            }
+            const auto done = Clock::now();
+            
+            local.responseTime[type].record(toMicros(done - intended));
+            local.serviceTime[type].record(toMicros(done - actual));
+            
+            auto second = static_cast<std::size_t>(toMicros(done - start) / 1000000);
+            if (second >= local.completedPerSecond[type].size()) {
+                local.completedPerSecond[type].resize(second + 1, 0);
+            }
+            ++local.completedPerSecond[type][second];
+        }
+        
+        std::lock_guard<std::mutex> lock(statsMutex);
+        total.merge(local);
+    };
+    
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < connections.size(); ++i) {
+        workers.emplace_back(worker, std::ref(*connections[i]), static_cast<unsigned>(i + 1));
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    double elapsed = std::chrono::duration<double>(std::max(Clock::now(), deadline) - start).count();
+    printReport(total, elapsed, scheduled);
+}
+
+void WorkloadGenerator::printReport(const Stats& stats, double elapsedSeconds, long long scheduled) const {
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "*** LATENCY PERCENTILES (ms) ***" << std::endl;
+    std::cout << std::left << std::setw(16) << "Operation" << std::right
+              << std::setw(10) << "count" << std::setw(10) << "p50" << std::setw(10) << "p90"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "p99.99"
+              << std::setw(10) << "max" << std::setw(10) << "mean" << std::endl;
+    for (int type = 0; type < OPERATION_TYPES; ++type) {
+        std::string response = std::string(OPERATION_NAMES[type]) + " response";
+        std::string service = std::string(OPERATION_NAMES[type]) + " service";
+        printPercentileRow(response.c_str(), stats.responseTime[type]);
+        printPercentileRow(service.c_str(), stats.serviceTime[type]);
+    }
+    std::cout << "Response time is measured from the scheduled start (includes queueing)," << std::endl;
+    std::cout << "service time from the moment the worker actually sent the request." << std::endl;
+    
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << "*** THROUGHPUT OVER TIME (completed ops) ***" << std::endl;
+    std::cout << std::setw(8) << "second" << std::setw(10) << "reads" << std::setw(10) << "writes"
+              << std::setw(10) << "total" << std::endl;
+    std::size_t seconds = std::max(stats.completedPerSecond[READ].size(), stats.completedPerSecond[WRITE].size());
+    while (seconds > 0 &&
+           (seconds > stats.completedPerSecond[READ].size() || stats.completedPerSecond[READ][seconds - 1] == 0) &&
+           (seconds > stats.completedPerSecond[WRITE].size() || stats.completedPerSecond[WRITE][seconds - 1] == 0)) {
+        --seconds;
+    }
+    for (std::size_t second = 0; second < seconds; ++second) {
+        long long reads = second < stats.completedPerSecond[READ].size() ? stats.completedPerSecond[READ][second] : 0;
+        long long writes = second < stats.completedPerSecond[WRITE].size() ? stats.completedPerSecond[WRITE][second] : 0;
+        std::cout << std::setw(8) << second << std::setw(10) << reads << std::setw(10) << writes
+                  << std::setw(10) << reads + writes << std::endl;
+    }
+    
+    long long completed = stats.responseTime[READ].count() + stats.responseTime[WRITE].count();
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << "Scheduled operations: " << scheduled << std::endl;
+    std::cout << "Completed operations: " << completed << std::endl;
+    std::cout << "Errors (read/write):  " << stats.errors[READ] << " / " << stats.errors[WRITE] << std::endl;
+    std::cout << "Target rate:   " << std::fixed << std::setprecision(2) << settings.targetRate << " ops/s" << std::endl;
+    std::cout << "Achieved rate: " << completed / elapsedSeconds << " ops/s" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+}
@@ -10,7 +10,10 @@ int main(int argc, char* argv[]) {
             Config::DB_PORT,
             Config::DB_NAME,
             Config::DB_USER,
-            Config::DB_PASSWORD
+            Config::DB_PASSWORD,
+            Config::DB_REPLICAS,
+            Config::DB_READ_ROUTING,
+            Config::DB_SHARDS
         );
         
         return app.run(argc, argv);